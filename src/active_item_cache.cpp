@@ -51,14 +51,15 @@ bool active_item_cache::add( item &it, point location, item *parent,
             return true;
         }
     }
-    item_reference ref{ location, it.get_safe_reference(), parent, pocket_chain };
+    item_reference ref{ location, it.get_safe_reference(), parent, pocket_chain, calendar::turn };
     if( it.can_revive() ) {
         special_items[special_item_type::corpse].emplace_back( ref );
     }
     if( it.get_use( "explosion" ) ) {
         special_items[special_item_type::explosive].emplace_back( ref );
     }
-    target_list.emplace_back( std::move( ref ) );
+    // Due right away, so it goes in front of the items that are already scheduled
+    target_list.emplace_front( std::move( ref ) );
     target_index.emplace( &it, it.get_safe_reference() );
     return true;
 }
@@ -89,29 +90,27 @@ std::vector<item_reference> active_item_cache::get()
 
 std::vector<item_reference> active_item_cache::get_for_processing()
 {
+    const time_point now = calendar::turn;
     std::vector<item_reference> items_to_process;
-    items_to_process.reserve( std::accumulate( active_items.begin(), active_items.end(), std::size_t{ 0 },
-    []( size_t prev, const auto & kv ) {
-        return prev + kv.second.size() / static_cast<size_t>( kv.first );
-    } ) );
     for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = kv.second.size() / kv.first;
-        std::list<item_reference>::iterator it = kv.second.begin();
-        for( ; it != kv.second.end() && num_to_process >= 0; ) {
+        const time_duration interval = time_duration::from_turns( kv.first );
+        std::list<item_reference> &items = kv.second;
+        // Lists are ordered by next_due, so stop at the first item that isn't due yet.
+        // Items due further away than one interval were scheduled before time went backwards.
+        std::list<item_reference>::iterator it = items.begin();
+        while( it != items.end() && ( it->next_due <= now || it->next_due > now + interval ) ) {
             if( it->item_ref ) {
+                it->next_due = now + interval;
                 items_to_process.push_back( *it );
-                --num_to_process;
                 ++it;
             } else {
                 // The item has been destroyed, so remove the reference from the cache
                 active_items_index[kv.first].clear();
-                it = kv.second.erase( it );
+                it = items.erase( it );
             }
         }
-        // Rotate the returned items to the end of their list so that the items that weren't
-        // returned this time will be first in line on the next call
-        kv.second.splice( kv.second.end(), kv.second, kv.second.begin(), it );
+        // Rotate the returned items to the end of their list, behind everything due earlier
+        items.splice( items.end(), items, items.begin(), it );
     }
     return items_to_process;
 }
@@ -161,3 +160,30 @@ void active_item_cache::mirror( const point &dim, bool horizontally )
         }
     }
 }
+
+static std::map<itype_id, active_item_stats::entry> &active_item_stats_storage()
+{
+    static std::map<itype_id, active_item_stats::entry> stats;
+    return stats;
+}
+
+void active_item_stats::record( const itype_id &type, std::chrono::steady_clock::duration spent,
+                                bool destroyed )
+{
+    entry &e = active_item_stats_storage()[type];
+    e.calls++;
+    e.total += spent;
+    if( destroyed ) {
+        e.destroyed++;
+    }
+}
+
+const std::map<itype_id, active_item_stats::entry> &active_item_stats::get()
+{
+    return active_item_stats_storage();
+}
+
+void active_item_stats::reset()
+{
+    active_item_stats_storage().clear();
+}
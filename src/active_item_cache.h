@@ -2,13 +2,17 @@
 #ifndef CATA_SRC_ACTIVE_ITEM_CACHE_H
 #define CATA_SRC_ACTIVE_ITEM_CACHE_H
 
+#include <chrono>
 #include <cstddef>
 #include <list>
+#include <map>
 #include <unordered_map>
 #include <vector>
 
+#include "calendar.h"
 #include "point.h"
 #include "safe_reference.h"
+#include "type_id.h"
 
 class item;
 class item_pocket;
@@ -20,6 +24,8 @@ struct item_reference {
     // parent invalidating would also invalidate item_ref so it's safe to use a raw pointers here
     item *parent = nullptr;
     std::vector<item_pocket const *> pocket_chain;
+    // Turn on which the item is next handed out for processing
+    time_point next_due = calendar::turn_zero;
 
     float spoil_multiplier();
 };
@@ -73,9 +79,10 @@ class active_item_cache
         std::vector<item_reference> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * Returns the items that are due for processing this turn. Every list works as a timing
+         * wheel: a returned item is rescheduled processing_speed() turns later and rotated to the
+         * back of its list, so each item is visited once per processing_speed() turns no matter
+         * how many items share the list. Newly added items are due right away.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
          * Relies on the fact that item::processing_speed() is a constant.
@@ -92,4 +99,18 @@ class active_item_cache
         void mirror( const point &dim, bool horizontally );
 };
 
+/** Accounting of the time spent processing active items on the map, by item type */
+namespace active_item_stats
+{
+struct entry {
+    int calls = 0;
+    int destroyed = 0;
+    std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero();
+};
+
+void record( const itype_id &type, std::chrono::steady_clock::duration spent, bool destroyed );
+const std::map<itype_id, entry> &get();
+void reset();
+} // namespace active_item_stats
+
 #endif // CATA_SRC_ACTIVE_ITEM_CACHE_H
@@ -87,6 +87,9 @@ static const trap_str_id tr_unfinished_construction( "tr_unfinished_construction
 static const std::string ITEM_HIGHLIGHT( "highlight_item" );
 static const std::string ZOMBIE_REVIVAL_INDICATOR( "zombie_revival_indicator" );
 
+// Incremented by cata_tiles::set_draw_cache_dirty, see cata_tiles::retained_frame
+static int draw_cache_generation = 0;
+
 static const std::array<std::string, 8> multitile_keys = {{
         "center",
         "corner",
@@ -229,6 +232,7 @@ cata_tiles::~cata_tiles() = default;
 
 void cata_tiles::on_options_changed()
 {
+    last_frame.valid = false;
     memory_map_mode = get_option <std::string>( "MEMORY_MAP_MODE" );
 
     pixel_minimap_settings settings;
@@ -323,9 +327,85 @@ tile_type &tileset::create_tile_type( const std::string &id, tile_type &&new_til
     return inserted_tile;
 }
 
+void tile_lookup_cache::clear()
+{
+    terrain.clear();
+    furniture.clear();
+    traps.clear();
+    fields.clear();
+    monsters.clear();
+    items.clear();
+    corpses.clear();
+}
+
+void tile_lookup_cache::set_season( const season_type new_season )
+{
+    if( season != new_season ) {
+        clear();
+        season = new_season;
+    }
+}
+
+template<typename T>
+static tile_lookup_cache::entry &lookup_cache_entry( std::vector<tile_lookup_cache::entry> &entries,
+        const int_id<T> &id )
+{
+    const size_t index = id.to_i();
+    if( index >= entries.size() ) {
+        entries.resize( index + 1 );
+    }
+    return entries[index];
+}
+
+tile_lookup_cache::entry &tile_lookup_cache::get( const ter_id &id )
+{
+    return lookup_cache_entry( terrain, id );
+}
+
+tile_lookup_cache::entry &tile_lookup_cache::get( const furn_id &id )
+{
+    return lookup_cache_entry( furniture, id );
+}
+
+tile_lookup_cache::entry &tile_lookup_cache::get( const trap_id &id )
+{
+    return lookup_cache_entry( traps, id );
+}
+
+tile_lookup_cache::entry &tile_lookup_cache::get( const field_type_id &id, const int intensity )
+{
+    const size_t index = id.to_i();
+    if( index >= fields.size() ) {
+        fields.resize( index + 1 );
+    }
+    std::vector<entry> &by_intensity = fields[index];
+    const size_t intensity_index = std::max( intensity, 0 );
+    if( intensity_index >= by_intensity.size() ) {
+        by_intensity.resize( intensity_index + 1 );
+    }
+    return by_intensity[intensity_index];
+}
+
+tile_lookup_cache::entry &tile_lookup_cache::get( const mtype_id &id )
+{
+    return monsters[id];
+}
+
+tile_lookup_cache::entry &tile_lookup_cache::get( const itype_id &id )
+{
+    return items[id];
+}
+
+tile_lookup_cache::entry &tile_lookup_cache::get_corpse( const mtype_id &id )
+{
+    return corpses[id];
+}
+
 void cata_tiles::load_tileset( const std::string &tileset_id, const bool precheck,
                                const bool force, const bool pump_events )
 {
+    // This is also called after the game data has been (re)loaded, which invalidates int ids.
+    lookup_cache.clear();
     if( tileset_ptr && tileset_ptr->get_tileset_id() == tileset_id && !force ) {
         return;
     }
@@ -1268,6 +1348,92 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     }
 #endif
 
+    const SDL_Rect view_rect = { dest.x, dest.y, width, height };
+    const avatar &you = get_avatar();
+    const bool retain = can_retain_frame();
+    if( retain && last_frame.valid && last_frame.dest == dest && last_frame.center == center &&
+        last_frame.size == point( width, height ) && last_frame.turn == calendar::turn &&
+        last_frame.moves == you.get_moves() && last_frame.player_pos == you.pos() &&
+        last_frame.generation == draw_cache_generation &&
+        last_frame.drawn_tileset == tileset_ptr.get() &&
+        last_frame.tile_size == point( tile_width, tile_height ) ) {
+        RenderCopy( renderer, last_frame.texture, &view_rect, &view_rect );
+        overlay_strings = last_frame.overlay_strings;
+        color_blocks = last_frame.color_blocks;
+        return;
+    }
+    last_frame.valid = false;
+
+    bool render_to_texture = false;
+    if( retain ) {
+        const point texture_size( dest.x + width, dest.y + height );
+        // don't retry if creating a texture of this size failed before
+        if( last_frame.texture_size != texture_size ) {
+            last_frame.texture = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888,
+                                                SDL_TEXTUREACCESS_TARGET, texture_size.x, texture_size.y );
+            last_frame.texture_size = texture_size;
+            if( last_frame.texture ) {
+                SetTextureBlendMode( last_frame.texture, SDL_BLENDMODE_NONE );
+            }
+        }
+        render_to_texture = static_cast<bool>( last_frame.texture );
+    }
+    if( render_to_texture ) {
+        SetRenderTarget( renderer, last_frame.texture );
+    }
+    drew_idle_animation = false;
+    const int generation = draw_cache_generation;
+    draw_tiles( dest, center, width, height, overlay_strings, color_blocks );
+    if( !render_to_texture ) {
+        return;
+    }
+    set_displaybuffer_rendertarget();
+    RenderCopy( renderer, last_frame.texture, &view_rect, &view_rect );
+    // draw_tiles may have found things to update (e.g. the visibility cache) and marked the
+    // draw cache as dirty again, in which case it has to be redrawn next time
+    if( drew_idle_animation || generation != draw_cache_generation ) {
+        return;
+    }
+    last_frame.valid = true;
+    last_frame.generation = generation;
+    last_frame.dest = dest;
+    last_frame.center = center;
+    last_frame.size = point( width, height );
+    last_frame.turn = calendar::turn;
+    last_frame.moves = you.get_moves();
+    last_frame.player_pos = you.pos();
+    last_frame.drawn_tileset = tileset_ptr.get();
+    last_frame.tile_size = point( tile_width, tile_height );
+    last_frame.overlay_strings = overlay_strings;
+    last_frame.color_blocks = color_blocks;
+}
+
+bool cata_tiles::can_retain_frame() const
+{
+    static const std::array<action_id, 9> overlays = { {
+            ACTION_DISPLAY_SCENT, ACTION_DISPLAY_SCENT_TYPE, ACTION_DISPLAY_TEMPERATURE,
+            ACTION_DISPLAY_VEHICLE_AI, ACTION_DISPLAY_VISIBILITY, ACTION_DISPLAY_LIGHTING,
+            ACTION_DISPLAY_RADIATION, ACTION_DISPLAY_TRANSPARENCY, ACTION_DISPLAY_NPC_ATTACK_POTENTIAL
+        }
+    };
+    if( std::any_of( overlays.begin(), overlays.end(), []( const action_id overlay ) {
+    return g->display_overlay_state( overlay );
+    } ) ) {
+        return false;
+    }
+    // animations and tile overrides change from frame to frame
+    return !do_draw_explosion && !do_draw_custom_explosion && !do_draw_bullet && !do_draw_hit &&
+           !do_draw_line && !do_draw_cursor && !do_draw_highlight && !do_draw_weather &&
+           !do_draw_sct && !do_draw_zones && !do_draw_async_anim && radiation_override.empty() && terrain_override.empty() && furniture_override.empty() &&
+           graffiti_override.empty() && trap_override.empty() && field_override.empty() &&
+           item_override.empty() && vpart_override.empty() && draw_below_override.empty() &&
+           monster_override.empty();
+}
+
+void cata_tiles::draw_tiles( const point &dest, const tripoint &center, int width, int height,
+                             std::multimap<point, formatted_text> &overlay_strings,
+                             color_block_overlay_container &color_blocks )
+{
     {
         //set clipping to prevent drawing over stuff we shouldn't
         SDL_Rect clipRect = {dest.x, dest.y, width, height};
@@ -1280,6 +1446,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
 
     const point s = get_window_base_tile_counts( point( width, height ) );
 
+    lookup_cache.set_season( season_of_year( calendar::turn ) );
     init_light();
     map &here = get_map();
     const visibility_variables &cache = here.get_visibility_variables_cache();
@@ -1908,6 +2075,8 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
 void cata_tiles::set_draw_cache_dirty()
 {
     get_map().draw_points_cache_dirty = true;
+    // shared by all tile contexts, as only the active one is notified
+    ++draw_cache_generation;
 }
 
 void cata_tiles::draw_minimap( const point &dest, const tripoint &center, int width, int height )
@@ -2239,6 +2408,16 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
             ll, -1, apply_night_vision_goggles, height_3d, intensity_level,
             variant, offset );
 }
+
+bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY category,
+                                      const std::string &subcategory, const tripoint &pos,
+                                      int subtile, int rota, lit_level ll,
+                                      bool apply_night_vision_goggles, int &height_3d,
+                                      int intensity_level, tile_lookup_cache::entry &cached )
+{
+    return cata_tiles::draw_from_id_string_internal( id, category, subcategory, pos, subtile, rota,
+            ll, -1, apply_night_vision_goggles, height_3d, intensity_level, "", point(), &cached );
+}
 bool cata_tiles::draw_from_id_string_internal( const std::string &id, const tripoint &pos,
         int subtile,
         int rota,
@@ -2466,7 +2645,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
         int subtile, int rota, lit_level ll, int retract,
         bool apply_night_vision_goggles, int &height_3d,
         int intensity_level, const std::string &variant,
-        const point &offset )
+        const point &offset, tile_lookup_cache::entry *cached )
 {
     bool nv_color_active = apply_night_vision_goggles && get_option<bool>( "NV_GREEN_TOGGLE" );
     // If the ID string does not produce a drawable tile
@@ -2475,6 +2654,21 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
 
     const tile_type *tt = nullptr;
     std::optional<tile_lookup_res> res;
+    // the transparent tile doesn't share multitile and seed cache entries with the regular one
+    bool found_transparent = false;
+
+    // Runs the lookup, or reuses its result from the cache entry if there is one.
+    const auto find_cached = [&]( tile_lookup_cache::memo tile_lookup_cache::entry::*memo,
+    const auto & lookup ) -> std::optional<tile_lookup_res> {
+        if( cached == nullptr ) {
+            return lookup();
+        }
+        tile_lookup_cache::memo &result = cached->*memo;
+        if( !result ) {
+            result = lookup();
+        }
+        return *result;
+    };
 
     // translate from player-relative to screen relative tile position
     const point screen_pos = player_to_screen( pos.xy() );
@@ -2498,9 +2692,12 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
         }
 
         if( prevent_occlusion_transp && retract > 0 ) {
-            res = find_tile_looks_like( id + "_transparent", category, variant );
+            res = find_cached( &tile_lookup_cache::entry::transparent, [&]() {
+                return find_tile_looks_like( id + "_transparent", category, variant );
+            } );
             if( res ) {
                 tt = &res -> tile();
+                found_transparent = true;
             }
         }
     }
@@ -2508,18 +2705,27 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
     // check if there is an available intensity tile and if there is use that instead of the basic tile
     // this is only relevant for fields
     if( intensity_level > 0 ) {
-        res = find_tile_looks_like( id + "_int" + std::to_string( intensity_level ), category, variant );
+        res = find_cached( &tile_lookup_cache::entry::intensity, [&]() {
+            return find_tile_looks_like( id + "_int" + std::to_string( intensity_level ), category,
+                                         variant );
+        } );
         if( res ) {
             tt = &res -> tile();
         }
+        found_transparent = false;
     }
     // if a tile with intensity hasn't already been found then fall back to a base tile
     if( !res ) {
-        res = find_tile_looks_like( id, category, variant );
+        res = find_cached( &tile_lookup_cache::entry::base, [&]() {
+            return find_tile_looks_like( id, category, variant );
+        } );
         if( res ) {
             tt = &res -> tile();
         }
     }
+    if( found_transparent ) {
+        cached = nullptr;
+    }
 
     map &here = get_map();
     const std::string &found_id = res ? res->id() : id;
@@ -2728,10 +2934,23 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
         const auto &display_subtiles = display_tile.available_subtiles;
         const auto end = std::end( display_subtiles );
         if( std::find( begin( display_subtiles ), end, multitile_keys[subtile] ) != end ) {
+            tile_lookup_cache::entry *subtile_cached = nullptr;
+            if( cached ) {
+                if( cached->subtiles.empty() ) {
+                    cached->subtiles.resize( multitile_keys.size() );
+                }
+                subtile_cached = &cached->subtiles[subtile];
+                if( subtile_cached->base && *subtile_cached->base ) {
+                    // already resolved, no need to build the id of the subtile
+                    return draw_from_id_string_internal(
+                               ( *subtile_cached->base )->id(), category, subcategory, pos, -1, rota, ll,
+                               retract, nv_color_active, height_3d, 0, "", point(), subtile_cached );
+                }
+            }
             // append subtile name to tile and re-find display_tile
             return draw_from_id_string_internal(
                        found_id + "_" + multitile_keys[subtile], category, subcategory, pos, -1, rota, ll,
-                       retract, nv_color_active, height_3d, 0, "", point() );
+                       retract, nv_color_active, height_3d, 0, "", point(), subtile_cached );
         }
     }
 
@@ -2777,12 +2996,21 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
             // since we won't get the behavior that occurs where the tile constantly
             // changes when the player grabs the furniture and drags it, causing the
             // seed to change.
-            const furn_str_id fid( found_id );
-            if( fid.is_valid() ) {
-                const furn_t &f = fid.obj();
-                if( !f.is_movable() ) {
-                    seed = simple_point_hash( here.getabs( pos ) );
+            const auto is_immovable = [&found_id]() {
+                const furn_str_id fid( found_id );
+                return fid.is_valid() && !fid->is_movable();
+            };
+            bool seed_by_position;
+            if( cached ) {
+                if( !cached->seed_by_position ) {
+                    cached->seed_by_position = is_immovable();
                 }
+                seed_by_position = *cached->seed_by_position;
+            } else {
+                seed_by_position = is_immovable();
+            }
+            if( seed_by_position ) {
+                seed = simple_point_hash( here.getabs( pos ) );
             }
         }
         break;
@@ -2862,6 +3090,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
 
         // idle tile animations:
         if( display_tile.animated ) {
+            drew_idle_animation = true;
             // idle animations run during the user's turn, and the animation speed
             // needs to be defined by the tileset to look good, so we use system clock:
             std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
@@ -3270,7 +3499,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             return memorize_only
                    ? false
                    : draw_from_id_string( tname, TILE_CATEGORY::TERRAIN, empty_string, p, subtile,
-                                          rotation, ll, nv_goggles_activated, height_3d );
+                                          rotation, ll, nv_goggles_activated, height_3d, 0,
+                                          lookup_cache.get( t ) );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -3299,7 +3529,7 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             return memorize_only
                    ? false
                    : draw_from_id_string( tname, TILE_CATEGORY::TERRAIN, empty_string, p, subtile,
-                                          rotation, lit, nv, height_3d );
+                                          rotation, lit, nv, height_3d, 0, lookup_cache.get( t2 ) );
         }
     } else if( invisible[0] ) {
         // try drawing memory if invisible and not overridden
@@ -3361,7 +3591,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             return memorize_only
                    ? false
                    : draw_from_id_string( fname, TILE_CATEGORY::FURNITURE, empty_string, p, subtile,
-                                          rotation, ll, nv_goggles_activated, height_3d );
+                                          rotation, ll, nv_goggles_activated, height_3d, 0,
+                                          lookup_cache.get( f ) );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -3400,7 +3631,7 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             return memorize_only
                    ? false
                    : draw_from_id_string( fname, TILE_CATEGORY::FURNITURE, empty_string, p, subtile,
-                                          rotation, lit, nv, height_3d );
+                                          rotation, lit, nv, height_3d, 0, lookup_cache.get( f2 ) );
         }
     } else if( invisible[0] ) {
         // try drawing memory if invisible and not overridden
@@ -3454,7 +3685,8 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
             return memorize_only
                    ? false
                    : draw_from_id_string( trname, TILE_CATEGORY::TRAP, empty_string, p, subtile,
-                                          rotation, ll, nv_goggles_activated, height_3d );
+                                          rotation, ll, nv_goggles_activated, height_3d, 0,
+                                          lookup_cache.get( tr.loadid ) );
         }
     }
     if( overridden || ( !invisible[0] && neighborhood_overridden &&
@@ -3486,7 +3718,7 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
             return memorize_only
                    ? false
                    : draw_from_id_string( trname, TILE_CATEGORY::TRAP, empty_string, p, subtile,
-                                          rotation, lit, nv, height_3d );
+                                          rotation, lit, nv, height_3d, 0, lookup_cache.get( tr2 ) );
         }
     } else if( invisible[0] ) {
         // try drawing memory if invisible and not overridden
@@ -3661,7 +3893,8 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
                 // draw the default sprite
                 if( !has_drawn ) {
                     ret_draw_field = draw_from_id_string( fld.id().str(), TILE_CATEGORY::FIELD, empty_string,
-                                                          p, subtile, rotation, lit, nv, height_3d, intensity );
+                                                          p, subtile, rotation, lit, nv, height_3d, intensity,
+                                                          lookup_cache.get( fld, intensity ) );
                 }
 
             }
@@ -3693,7 +3926,8 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
             //get field intensity
             int intensity = fld_overridden ? 0 : here.field_at( p ).displayed_intensity();
             ret_draw_field = draw_from_id_string( fld.id().str(), TILE_CATEGORY::FIELD, empty_string,
-                                                  p, subtile, rotation, lit, nv, height_3d, intensity );
+                                                  p, subtile, rotation, lit, nv, height_3d, intensity,
+                                                  lookup_cache.get( fld, intensity ) );
         }
     }
 
@@ -3826,14 +4060,21 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
             }
             if( it_type && !it_id.is_null() ) {
 
-                const std::string disp_id = it_id == itype_corpse && mon_id ?
-                                            "corpse_" + mon_id.str() : it_id.str();
+                const bool is_corpse = it_id == itype_corpse && mon_id;
+                const std::string disp_id = is_corpse ? "corpse_" + mon_id.str() : it_id.str();
                 const std::string it_category = it_type->get_item_type_string();
                 const lit_level lit = it_overridden ? lit_level::LIT : ll;
                 const bool nv = it_overridden ? false : nv_goggles_activated;
 
-                ret_draw_items = draw_from_id_string( disp_id, TILE_CATEGORY::ITEM, it_category, p, 0,
-                                                      0, lit, nv, height_3d, 0, variant );
+                if( variant.empty() ) {
+                    tile_lookup_cache::entry &cached = is_corpse ? lookup_cache.get_corpse( mon_id ) :
+                                                       lookup_cache.get( it_id );
+                    ret_draw_items = draw_from_id_string( disp_id, TILE_CATEGORY::ITEM, it_category, p, 0,
+                                                          0, lit, nv, height_3d, 0, cached );
+                } else {
+                    ret_draw_items = draw_from_id_string( disp_id, TILE_CATEGORY::ITEM, it_category, p, 0,
+                                                          0, lit, nv, height_3d, 0, variant );
+                }
                 if( ret_draw_items && hilite ) {
                     draw_item_highlight( p, height_3d );
                 }
@@ -4031,7 +4272,8 @@ bool cata_tiles::draw_critter_at( const tripoint &p, lit_level ll, int &height_3
         const std::string &ent_subcategory = id.obj().species.empty() ?
                                              empty_string : id.obj().species.begin()->str();
         result = draw_from_id_string( chosen_id, TILE_CATEGORY::MONSTER, ent_subcategory, p,
-                                      corner, 0, lit_level::LIT, false, height_3d );
+                                      corner, 0, lit_level::LIT, false, height_3d, 0,
+                                      lookup_cache.get( id ) );
     } else if( !invisible[0] || always_visible ) {
         if( pcritter == nullptr ) {
             return false;
@@ -4068,6 +4310,7 @@ bool cata_tiles::draw_critter_at( const tripoint &p, lit_level ll, int &height_3
             if( rot_facing >= -1 ) {
                 const mtype_id ent_name = m->type->id;
                 std::string chosen_id = ent_name.str();
+                bool ridden_tile = false;
                 if( m->has_effect( effect_ridden ) ) {
                     int pl_under_height = 6;
                     if( m->mounted_player ) {
@@ -4079,10 +4322,17 @@ bool cata_tiles::draw_critter_at( const tripoint &p, lit_level ll, int &height_3
                     const tile_type *tt = tileset_ptr->find_tile_type( ridden_id );
                     if( tt ) {
                         chosen_id = ridden_id;
+                        ridden_tile = true;
                     }
                 }
-                result = draw_from_id_string( chosen_id, ent_category, ent_subcategory, p,
-                                              subtile, rot_facing, ll, false, height_3d );
+                if( ridden_tile ) {
+                    result = draw_from_id_string( chosen_id, ent_category, ent_subcategory, p,
+                                                  subtile, rot_facing, ll, false, height_3d );
+                } else {
+                    result = draw_from_id_string( chosen_id, ent_category, ent_subcategory, p,
+                                                  subtile, rot_facing, ll, false, height_3d, 0,
+                                                  lookup_cache.get( ent_name ) );
+                }
                 sees_player = m->sees( you );
                 attitude = m->attitude_to( you );
             }
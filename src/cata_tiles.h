@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -379,6 +380,55 @@ class tileset_cache::loader
         void load( const std::string &tileset_id, bool precheck, bool pump_events = false );
 };
 
+/**
+ * Memoizes the tile lookups (season suffixes, intensity levels, multitile keys and looks_like
+ * chains) of game objects drawn every frame, keyed by their int ids or interned string ids,
+ * so the draw loop doesn't have to build and hash id strings for them.
+ * The cached results point into the current tileset, and int ids change when the game data is
+ * reloaded, so it must be cleared whenever a tileset is (re)loaded.
+ */
+class tile_lookup_cache
+{
+    public:
+        // Outer optional is empty until the lookup has been done, inner one holds its result.
+        using memo = std::optional<std::optional<tile_lookup_res>>;
+
+        struct entry {
+            memo base;
+            // "<id>_int<intensity>", only used by fields
+            memo intensity;
+            // "<id>_transparent", used for retracted tiles
+            memo transparent;
+            // whether the sprite variant is seeded by position (for furniture)
+            std::optional<bool> seed_by_position;
+            // entries of "<found id>_<multitile key>", indexed by subtile
+            std::vector<entry> subtiles;
+        };
+
+        void clear();
+        // Lookups are done for the current season, drops everything when it changes.
+        void set_season( season_type new_season );
+
+        entry &get( const ter_id &id );
+        entry &get( const furn_id &id );
+        entry &get( const trap_id &id );
+        entry &get( const field_type_id &id, int intensity );
+        entry &get( const mtype_id &id );
+        entry &get( const itype_id &id );
+        entry &get_corpse( const mtype_id &id );
+
+    private:
+        season_type season = NUM_SEASONS;
+        std::vector<entry> terrain;
+        std::vector<entry> furniture;
+        std::vector<entry> traps;
+        // indexed by field type, then intensity
+        std::vector<std::vector<entry>> fields;
+        std::unordered_map<mtype_id, entry> monsters;
+        std::unordered_map<itype_id, entry> items;
+        std::unordered_map<mtype_id, entry> corpses;
+};
+
 enum class text_alignment : int {
     left,
     center,
@@ -434,6 +484,14 @@ class cata_tiles
         /** Minimap functionality */
         void draw_minimap( const point &dest, const tripoint &center, int width, int height );
 
+    private:
+        /** Renders every visible tile, used by draw() when the retained frame can't be reused */
+        void draw_tiles( const point &dest, const tripoint &center, int width, int height,
+                         std::multimap<point, formatted_text> &overlay_strings,
+                         color_block_overlay_container &color_blocks );
+        /** Whether the current frame only depends on the state covered by @ref retained_frame */
+        bool can_retain_frame() const;
+
     protected:
         /** How many rows and columns of tiles fit into given dimensions, fully
          ** or partially shown, but disregarding any extra contents outside the
@@ -492,13 +550,19 @@ class cata_tiles
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d, int intensity_level,
                                   const std::string &variant, const point &offset );
+        /** Same as above, but memoizes the tile lookup in @p cached instead of looking up @p id. */
+        bool draw_from_id_string( const std::string &id, TILE_CATEGORY category,
+                                  const std::string &subcategory, const tripoint &pos, int subtile, int rota,
+                                  lit_level ll, bool apply_night_vision_goggles, int &height_3d, int intensity_level,
+                                  tile_lookup_cache::entry &cached );
         bool draw_from_id_string_internal( const std::string &id, const tripoint &pos, int subtile,
                                            int rota,
                                            lit_level ll, int retract, bool apply_night_vision_goggles, int &height_3d );
         bool draw_from_id_string_internal( const std::string &id, TILE_CATEGORY category,
                                            const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                            lit_level ll, int retract, bool apply_night_vision_goggles, int &height_3d, int intensity_level,
-                                           const std::string &variant, const point &offset );
+                                           const std::string &variant, const point &offset,
+                                           tile_lookup_cache::entry *cached = nullptr );
         bool draw_sprite_at(
             const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
             const point &, unsigned int loc_rand, bool rota_fg, int rota, lit_level ll,
@@ -747,6 +811,7 @@ class cata_tiles
         const GeometryRenderer_Ptr &geometry;
         tileset_cache &cache;
         std::shared_ptr<const tileset> tileset_ptr;
+        tile_lookup_cache lookup_cache;
 
         // the scaled default sprite width and height. in non-isometric mode,
         // the basic tile width and height equal the default sprite width and
@@ -764,6 +829,35 @@ class cata_tiles
 
         int fog_alpha = 0;
 
+        /**
+         * The map view rendered by the last draw() call, kept in a texture so that frames in
+         * which nothing on the map changed (e.g. the map being redrawn below a menu) are copied
+         * instead of drawn tile by tile. Invalidated by set_draw_cache_dirty(), which is called
+         * whenever the map, creatures or lighting may have changed.
+         */
+        struct retained_frame {
+            SDL_Texture_Ptr texture;
+            point texture_size;
+            bool valid = false;
+            // value of the draw cache generation counter when the frame was drawn
+            int generation = 0;
+            // what the frame was drawn for, besides the map itself
+            point dest;
+            tripoint center;
+            point size;
+            time_point turn;
+            int moves = 0;
+            tripoint player_pos;
+            const tileset *drawn_tileset = nullptr;
+            point tile_size;
+            // output of draw_tiles for the frame
+            std::multimap<point, formatted_text> overlay_strings;
+            color_block_overlay_container color_blocks;
+        };
+        retained_frame last_frame;
+        // Set when a tile with an idle animation has been drawn, such frames must not be retained.
+        bool drew_idle_animation = false;
+
         bool in_animation = false;
 
         bool disable_occlusion = false;
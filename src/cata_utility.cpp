@@ -22,8 +22,10 @@
 #include "cata_path.h"
 #include "catacharset.h"
 #include "debug.h"
+#include "deferred_writes.h"
 #include "filesystem.h"
 #include "flexbuffer_json.h"
+#include "gzip_ostream.h"
 #include "json.h"
 #include "json_loader.h"
 #include "ofstream_wrapper.h"
@@ -285,26 +287,47 @@ float multi_lerp( const std::vector<std::pair<float, float>> &points, float x )
     return ( t * points[i].second ) + ( ( 1 - t ) * points[i - 1].second );
 }
 
-void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer )
+static void write_to_file( const fs::path &path,
+                           const std::function<void( std::ostream & )> &writer,
+                           const char *const description, const int compression_level = 0,
+                           const cata_path *save_file = nullptr )
 {
+    if( deferred_writes::active() ) {
+        std::ostringstream buffer;
+        writer( buffer );
+        deferred_writes::enqueue( path, buffer.str(), description, compression_level, save_file );
+        return;
+    }
+    if( save_file ) {
+        // The contents are streamed straight to disk, so the next load parses and caches them.
+        json_loader::invalidate_save_cache( *save_file );
+    }
     // Any of the below may throw. ofstream_wrapper will clean up the temporary path on its own.
-    ofstream_wrapper fout( fs::u8path( path ), std::ios::binary );
-    writer( fout.stream() );
+    ofstream_wrapper fout( path, std::ios::binary );
+    if( compression_level > 0 ) {
+        gzip_ostream zout( fout.stream(), compression_level );
+        writer( zout );
+        zout.finish();
+    } else {
+        writer( fout.stream() );
+    }
     fout.close();
 }
 
-bool write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
-                    const char *const fail_message )
+static bool try_write_to_file( const fs::path &path,
+                               const std::function<void( std::ostream & )> &writer,
+                               const char *const fail_message, const int compression_level = 0,
+                               const cata_path *save_file = nullptr )
 {
     try {
-        write_to_file( path, writer );
+        write_to_file( path, writer, fail_message, compression_level, save_file );
         return true;
 
     } catch( const std::exception &err ) {
         if( fail_message ) {
             const std::string msg =
                 string_format( _( "Failed to write %1$s to \"%2$s\": %3$s" ),
-                               fail_message, path, err.what() );
+                               fail_message, path.generic_u8string(), err.what() );
             if( test_mode ) {
                 DebugLog( D_ERROR, DC_ALL ) << msg;
             } else {
@@ -315,34 +338,54 @@ bool write_to_file( const std::string &path, const std::function<void( std::ostr
     }
 }
 
+void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer )
+{
+    write_to_file( fs::u8path( path ), writer, nullptr );
+}
+
+bool write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
+                    const char *const fail_message )
+{
+    return try_write_to_file( fs::u8path( path ), writer, fail_message );
+}
+
 void write_to_file( const cata_path &path, const std::function<void( std::ostream & )> &writer )
 {
-    // Any of the below may throw. ofstream_wrapper will clean up the temporary path on its own.
-    ofstream_wrapper fout( path.get_unrelative_path(), std::ios::binary );
-    writer( fout.stream() );
-    fout.close();
+    write_to_file( path.get_unrelative_path(), writer, nullptr );
 }
 
 bool write_to_file( const cata_path &path, const std::function<void( std::ostream & )> &writer,
                     const char *const fail_message )
 {
-    try {
-        write_to_file( path, writer );
-        return true;
+    return try_write_to_file( path.get_unrelative_path(), writer, fail_message );
+}
 
-    } catch( const std::exception &err ) {
-        if( fail_message ) {
-            const std::string msg =
-                string_format( _( "Failed to write %1$s to \"%2$s\": %3$s" ),
-                               fail_message, path.generic_u8string(), err.what() );
-            if( test_mode ) {
-                DebugLog( D_ERROR, DC_ALL ) << msg;
-            } else {
-                popup( "%s", msg );
-            }
-        }
-        return false;
-    }
+static int save_compression_level()
+{
+    return get_option<int>( "SAVE_COMPRESSION" );
+}
+
+void write_save_file( const std::string &path, const std::function<void( std::ostream & )> &writer )
+{
+    write_to_file( fs::u8path( path ), writer, nullptr, save_compression_level() );
+}
+
+bool write_save_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
+                      const char *const fail_message )
+{
+    return try_write_to_file( fs::u8path( path ), writer, fail_message, save_compression_level() );
+}
+
+void write_save_file( const cata_path &path, const std::function<void( std::ostream & )> &writer )
+{
+    write_to_file( path.get_unrelative_path(), writer, nullptr, save_compression_level(), &path );
+}
+
+bool write_save_file( const cata_path &path, const std::function<void( std::ostream & )> &writer,
+                      const char *const fail_message )
+{
+    return try_write_to_file( path.get_unrelative_path(), writer, fail_message,
+                              save_compression_level(), &path );
 }
 
 ofstream_wrapper::ofstream_wrapper( const fs::path &path, const std::ios::openmode mode )
@@ -476,6 +519,8 @@ std::unique_ptr<std::istream> read_maybe_compressed_file( const std::string &pat
 
 std::unique_ptr<std::istream> read_maybe_compressed_file( const fs::path &path )
 {
+    // The file may still be queued for writing by the last save.
+    deferred_writes::wait();
     try {
         std::ifstream fin( path, std::ios::binary );
         if( !fin ) {
@@ -562,6 +607,7 @@ std::optional<std::string> read_whole_file( const cata_path &path )
 bool read_from_file_json( const cata_path &path,
                           const std::function<void( const JsonValue & )> &reader )
 {
+    deferred_writes::wait();
     try {
         JsonValue jo = json_loader::from_path( path );
         reader( jo );
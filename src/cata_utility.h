@@ -325,6 +325,22 @@ bool write_to_file( const cata_path &path, const std::function<void( std::ostrea
 void write_to_file( const cata_path &path, const std::function<void( std::ostream & )> &writer );
 ///@}
 
+/**
+ * Like @ref write_to_file, for the bulk of a world's save data (map quads, overmaps, map memory,
+ * the player): the file is gzip-compressed when the "SAVE_COMPRESSION" world option asks for it.
+ * @ref read_from_file and friends tell compressed files apart on their own. Writes to a save
+ * path also keep the world's cached flexbuffer of the file in step, see
+ * @ref json_loader::update_save_cache.
+ */
+///@{
+bool write_save_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
+                      const char *fail_message );
+void write_save_file( const std::string &path, const std::function<void( std::ostream & )> &writer );
+bool write_save_file( const cata_path &path, const std::function<void( std::ostream & )> &writer,
+                      const char *fail_message );
+void write_save_file( const cata_path &path, const std::function<void( std::ostream & )> &writer );
+///@}
+
 /**
  * Try to open and read from given file using the given callback.
  *
@@ -7828,6 +7828,8 @@ void Character::recalculate_enchantment_cache()
         }
     }
 
+    rebuild_trait_bits();
+
     if( enchantment_cache->modifies_bodyparts() ) {
         recalculate_bodyparts();
     }
@@ -301,21 +301,14 @@ struct queued_eoc {
         std::unordered_map<std::string, std::string> context;
 };
 
-struct eoc_compare {
-    bool operator()( const queued_eoc &lhs, const queued_eoc &rhs ) const {
-        return lhs.time > rhs.time;
-    }
-};
-
+/**
+ * Calendar queue of eocs: entries live in @ref list and are bucketed by the turn they are due
+ * on, so a turn only touches the eocs that are actually due and rescheduling is a single insert.
+ */
 struct queued_eocs {
     using storage_iter = std::list<queued_eoc>::iterator;
 
-    struct eoc_compare : ::eoc_compare {
-        bool operator()( const storage_iter &lhs, const storage_iter &rhs ) const {
-            return ::eoc_compare::operator()( *lhs, *rhs );
-        }
-    };
-    std::priority_queue<storage_iter, std::vector<storage_iter>, eoc_compare> queue;
+    std::map<time_point, std::vector<storage_iter>> buckets;
     std::list<queued_eoc> list;
 
     queued_eocs() = default;
@@ -323,47 +316,64 @@ struct queued_eocs {
     queued_eocs( const queued_eocs &rhs ) {
         list = rhs.list;
         for( auto it = list.begin(), end = list.end(); it != end; ++it ) {
-            queue.emplace( it );
+            schedule( it );
         }
     };
     queued_eocs( queued_eocs &&rhs ) noexcept {
-        queue.swap( rhs.queue );
+        buckets.swap( rhs.buckets );
         list.swap( rhs.list );
     }
 
     queued_eocs &operator=( const queued_eocs &rhs ) {
         list = rhs.list;
-        // Why doesn't std::priority_queue have a clear() function.
-        queue = {};
+        buckets.clear();
         for( auto it = list.begin(), end = list.end(); it != end; ++it ) {
-            queue.emplace( it );
+            schedule( it );
         }
         return *this;
     }
     queued_eocs &operator=( queued_eocs &&rhs ) noexcept {
-        queue.swap( rhs.queue );
+        buckets.swap( rhs.buckets );
         list.swap( rhs.list );
         return *this;
     }
 
+    /** Puts an entry of @ref list into the bucket of its due turn */
+    void schedule( storage_iter it ) {
+        buckets[it->time].push_back( it );
+    }
+
+    /** Takes out all entries of the earliest bucket if it is due at @p now, they stay in @ref list */
+    std::vector<storage_iter> take_due( const time_point &now ) {
+        std::vector<storage_iter> due;
+        if( !buckets.empty() && buckets.begin()->first <= now ) {
+            due = std::move( buckets.begin()->second );
+            buckets.erase( buckets.begin() );
+        }
+        return due;
+    }
+
     /* std::priority_queue compatibility layer where performance is less relevant */
 
     bool empty() const {
-        return queue.empty();
+        return buckets.empty();
     }
 
     const queued_eoc &top() const {
-        return *queue.top();
+        return *buckets.begin()->second.front();
     }
 
     void push( const queued_eoc &eoc ) {
-        auto it = list.emplace( list.end(), eoc );
-        queue.push( it );
+        schedule( list.emplace( list.end(), eoc ) );
     }
 
     void pop() {
-        auto it = queue.top();
-        queue.pop();
+        auto bucket = buckets.begin();
+        storage_iter it = bucket->second.front();
+        bucket->second.erase( bucket->second.begin() );
+        if( bucket->second.empty() ) {
+            buckets.erase( bucket );
+        }
         list.erase( it );
     }
 };
@@ -3941,6 +3951,13 @@ class Character : public Creature, public visitable
          * Pointers to mutation branches in @ref my_mutations.
          */
         std::vector<const mutation_branch *> cached_mutations;
+        /**
+         * One bit per trait int id, set for the keys of @ref my_mutations and for the mutations
+         * granted by enchantments, so @ref has_trait is a bit test instead of two hash lookups.
+         */
+        std::vector<bool> trait_bits; // NOLINT(cata-serialize)
+        /** Rebuilds @ref trait_bits, needed whenever a mutation is gained or lost */
+        void rebuild_trait_bits();
 
         // if the player puts on and takes off items these mutations
         // are added or removed at the beginning of the next
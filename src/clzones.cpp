@@ -109,6 +109,7 @@ void zone_manager::clear()
     // Do not clear types since it is needed for the next games.
     area_cache.clear();
     vzone_cache.clear();
+    cache_revision++;
 }
 
 std::string zone_type::name() const
@@ -851,9 +852,52 @@ bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac
     return type_iter != area_cache.end();
 }
 
+static zone_manager::zone_area zone_area_of( const zone_data &zone )
+{
+    const tripoint_abs_ms start = zone.get_start_point();
+    const tripoint_abs_ms end = zone.get_end_point();
+    return zone_manager::zone_area(
+               tripoint_abs_ms( std::min( start.x(), end.x() ), std::min( start.y(), end.y() ),
+                                std::min( start.z(), end.z() ) ),
+               tripoint_abs_ms( std::max( start.x(), end.x() ), std::max( start.y(), end.y() ),
+                                std::max( start.z(), end.z() ) ) );
+}
+
+// the point of the area closest to p
+static tripoint_abs_ms closest_point( const zone_manager::zone_area &area,
+                                      const tripoint_abs_ms &p )
+{
+    return tripoint_abs_ms( clamp( p.x(), area.p_min.x(), area.p_max.x() ),
+                            clamp( p.y(), area.p_min.y(), area.p_max.y() ),
+                            clamp( p.z(), area.p_min.z(), area.p_max.z() ) );
+}
+
+static bool area_in_range( const zone_manager::zone_area &area, const tripoint_abs_ms &where,
+                           int range )
+{
+    return square_dist( closest_point( area, where ), where ) <= range;
+}
+
+// the part of the area within range of where, if any
+static std::optional<zone_manager::zone_area> area_clipped_to_range(
+    const zone_manager::zone_area &area, const tripoint_abs_ms &where, int range )
+{
+    if( !area_in_range( area, where, range ) ) {
+        return std::nullopt;
+    }
+    return zone_manager::zone_area(
+               tripoint_abs_ms( std::max( area.p_min.x(), where.x() - range ),
+                                std::max( area.p_min.y(), where.y() - range ),
+                                std::max( area.p_min.z(), where.z() - range ) ),
+               tripoint_abs_ms( std::min( area.p_max.x(), where.x() + range ),
+                                std::min( area.p_max.y(), where.y() + range ),
+                                std::min( area.p_max.z(), where.z() + range ) ) );
+}
+
 void zone_manager::cache_data( bool update_avatar )
 {
     area_cache.clear();
+    cache_revision++;
     avatar &player_character = get_avatar();
     tripoint_abs_ms cached_shift = player_character.get_location();
     for( zone_data &elem : zones ) {
@@ -867,14 +911,7 @@ void zone_manager::cache_data( bool update_avatar )
             elem.update_cached_shift( cached_shift );
         }
 
-        const std::string &type_hash = elem.get_type_hash();
-        auto &cache = area_cache[type_hash];
-
-        // Draw marked area
-        for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
-                 elem.get_start_point(), elem.get_end_point() ) ) {
-            cache.insert( p );
-        }
+        area_cache[elem.get_type_hash()].push_back( zone_area_of( elem ) );
     }
 }
 
@@ -909,6 +946,7 @@ void zone_manager::cache_avatar_location()
 void zone_manager::cache_vzones( map *pmap )
 {
     vzone_cache.clear();
+    cache_revision++;
     map &here = pmap == nullptr ? get_map() : *pmap;
     auto vzones = here.get_vehicle_zones( here.get_abs_sub().z() );
     for( zone_data *elem : vzones ) {
@@ -916,25 +954,18 @@ void zone_manager::cache_vzones( map *pmap )
             continue;
         }
 
-        const std::string &type_hash = elem->get_type_hash();
-        auto &cache = vzone_cache[type_hash];
-
-        // TODO: looks very similar to the above cache_data - maybe merge it?
-
-        // Draw marked area
-        for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
-                 elem->get_start_point(), elem->get_end_point() ) ) {
-            cache.insert( p );
-        }
+        vzone_cache[elem->get_type_hash()].push_back( zone_area_of( *elem ) );
     }
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_point_set( const zone_type_id &type,
-        const faction_id &fac ) const
+static const std::vector<zone_manager::zone_area> no_zone_areas;
+
+const std::vector<zone_manager::zone_area> &zone_manager::get_point_set(
+    const zone_type_id &type, const faction_id &fac ) const
 {
     const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
+        return no_zone_areas;
     }
 
     return type_iter->second;
@@ -951,35 +982,37 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_ab
 {
     std::unordered_set<tripoint> res;
     map &here = get_map();
-    for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : area_cache ) {
-        zone_type_id type = zone_data::unhash_type( cache.first );
-        faction_id z_fac = zone_data::unhash_fac( cache.first );
-        if( fac == z_fac && type.str().substr( 0, 4 ) == "LOOT" ) {
-            for( tripoint_abs_ms point : cache.second ) {
-                if( square_dist( where, point ) <= radius ) {
-                    res.emplace( here.getlocal( point ) );
-                }
+    const auto add_loot_points = [&]( const decltype( area_cache ) &cache ) {
+        for( const std::pair<const std::string, std::vector<zone_area>> &areas : cache ) {
+            zone_type_id type = zone_data::unhash_type( areas.first );
+            faction_id z_fac = zone_data::unhash_fac( areas.first );
+            if( fac != z_fac || type.str().substr( 0, 4 ) != "LOOT" ) {
+                continue;
             }
-        }
-    }
-    for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : vzone_cache ) {
-        zone_type_id type = zone_data::unhash_type( cache.first );
-        faction_id z_fac = zone_data::unhash_fac( cache.first );
-        if( fac == z_fac && type.str().substr( 0, 4 ) == "LOOT" ) {
-            for( tripoint_abs_ms point : cache.second ) {
-                if( square_dist( where, point ) <= radius ) {
+            for( const zone_area &area : areas.second ) {
+                const std::optional<zone_area> near_area = area_clipped_to_range( area, where, radius );
+                if( !near_area ) {
+                    continue;
+                }
+                for( const tripoint_abs_ms &point : tripoint_range<tripoint_abs_ms>(
+                         near_area->p_min, near_area->p_max ) ) {
                     res.emplace( here.getlocal( point ) );
                 }
             }
         }
-    }
+    };
+    add_loot_points( area_cache );
+    add_loot_points( vzone_cache );
 
     if( npc_search ) {
-        for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : vzone_cache ) {
-            zone_type_id type = zone_data::unhash_type( cache.first );
+        for( const std::pair<const std::string, std::vector<zone_area>> &areas : vzone_cache ) {
+            zone_type_id type = zone_data::unhash_type( areas.first );
             if( type == zone_type_NO_NPC_PICKUP ) {
-                for( tripoint_abs_ms point : cache.second ) {
-                    res.erase( here.getlocal( point ) );
+                for( const zone_area &area : areas.second ) {
+                    for( const tripoint_abs_ms &point : tripoint_range<tripoint_abs_ms>(
+                             area.p_min, area.p_max ) ) {
+                        res.erase( here.getlocal( point ) );
+                    }
                 }
             }
         }
@@ -988,13 +1021,13 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_ab
     return res;
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_vzone_set( const zone_type_id &type,
-        const faction_id &fac ) const
+const std::vector<zone_manager::zone_area> &zone_manager::get_vzone_set(
+    const zone_type_id &type, const faction_id &fac ) const
 {
     //Only regenerate the vehicle zone cache if any vehicles have moved
     const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
+        return no_zone_areas;
     }
 
     return type_iter->second;
@@ -1003,27 +1036,28 @@ std::unordered_set<tripoint_abs_ms> zone_manager::get_vzone_set( const zone_type
 bool zone_manager::has( const zone_type_id &type, const tripoint_abs_ms &where,
                         const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    const auto &vzone_set = get_vzone_set( type, fac );
-    return point_set.find( where ) != point_set.end() || vzone_set.find( where ) != vzone_set.end();
+    const auto contains_where = [&where]( const zone_area & area ) {
+        return area.contains( where );
+    };
+    const std::vector<zone_area> &point_set = get_point_set( type, fac );
+    const std::vector<zone_area> &vzone_set = get_vzone_set( type, fac );
+    return std::any_of( point_set.begin(), point_set.end(), contains_where ) ||
+           std::any_of( vzone_set.begin(), vzone_set.end(), contains_where );
 }
 
 bool zone_manager::has_near( const zone_type_id &type, const tripoint_abs_ms &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &point : point_set ) {
-        if( square_dist( point, where ) <= range ) {
+    for( const zone_area &area : get_point_set( type, fac ) ) {
+        if( area_in_range( area, where, range ) ) {
             return true;
         }
     }
 
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
+    for( const zone_area &area : get_vzone_set( type, fac ) ) {
+        if( area.p_min.z() <= where.z() && where.z() <= area.p_max.z() &&
+            area_in_range( area, where, range ) ) {
+            return true;
         }
     }
 
@@ -1134,27 +1168,33 @@ bool zone_manager::custom_loot_has( const tripoint_abs_ms &where, const item *it
 std::unordered_set<tripoint_abs_ms> zone_manager::get_near( const zone_type_id &type,
         const tripoint_abs_ms &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
     std::unordered_set<tripoint_abs_ms> near_point_set;
+    const bool filtered = type == zone_type_LOOT_CUSTOM || type == zone_type_LOOT_ITEM_GROUP;
+    if( filtered && it == nullptr ) {
+        return near_point_set;
+    }
 
-    for( const tripoint_abs_ms &point : point_set ) {
-        if( square_dist( point, where ) <= range ) {
-            if( ( type != zone_type_LOOT_CUSTOM && type != zone_type_LOOT_ITEM_GROUP ) ||
-                ( it != nullptr && custom_loot_has( point, it, type, fac ) ) ) {
+    const auto add_near_points = [&]( const zone_area & area ) {
+        const std::optional<zone_area> near_area = area_clipped_to_range( area, where, range );
+        if( !near_area ) {
+            return;
+        }
+        for( const tripoint_abs_ms &point : tripoint_range<tripoint_abs_ms>(
+                 near_area->p_min, near_area->p_max ) ) {
+            if( !filtered || custom_loot_has( point, it, type, fac ) ) {
                 near_point_set.insert( point );
             }
         }
+    };
+
+    for( const zone_area &area : get_point_set( type, fac ) ) {
+        add_near_points( area );
     }
 
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                if( ( type != zone_type_LOOT_CUSTOM && type != zone_type_LOOT_ITEM_GROUP ) ||
-                    ( it != nullptr && custom_loot_has( point, it, type, fac ) ) ) {
-                    near_point_set.insert( point );
-                }
-            }
+    for( const zone_area &area : get_vzone_set( type, fac ) ) {
+        if( area.p_min.z() <= where.z() && where.z() <= area.p_max.z() ) {
+            add_near_points( zone_area( tripoint_abs_ms( area.p_min.xy(), where.z() ),
+                                        tripoint_abs_ms( area.p_max.xy(), where.z() ) ) );
         }
     }
 
@@ -1170,8 +1210,8 @@ std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &ty
 
     tripoint_abs_ms nearest_pos( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint_abs_ms> &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &p : point_set ) {
+    for( const zone_area &area : get_point_set( type, fac ) ) {
+        const tripoint_abs_ms p = closest_point( area, where );
         int cur_dist = square_dist( p, where );
         if( cur_dist < nearest_dist ) {
             nearest_dist = cur_dist;
@@ -1182,8 +1222,8 @@ std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &ty
         }
     }
 
-    const std::unordered_set<tripoint_abs_ms> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &p : vzone_set ) {
+    for( const zone_area &area : get_vzone_set( type, fac ) ) {
+        const tripoint_abs_ms p = closest_point( area, where );
         int cur_dist = square_dist( p, where );
         if( cur_dist < nearest_dist ) {
             nearest_dist = cur_dist;
@@ -1202,8 +1242,6 @@ std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &ty
 zone_type_id zone_manager::get_near_zone_type_for_item( const item &it,
         const tripoint_abs_ms &where, int range, const faction_id &fac ) const
 {
-    const item_category &cat = it.get_category_of_contents();
-
     if( has_near( zone_type_LOOT_CUSTOM, where, range, fac ) ) {
         if( !get_near( zone_type_LOOT_CUSTOM, where, range, &it, fac ).empty() ) {
             return zone_type_LOOT_CUSTOM;
@@ -1214,6 +1252,35 @@ zone_type_id zone_manager::get_near_zone_type_for_item( const item &it,
             return zone_type_LOOT_ITEM_GROUP;
         }
     }
+
+    // Contents can change the category, the flags and whether food spoils
+    if( !it.empty() ) {
+        return get_near_zone_type_by_category( it, where, range, fac );
+    }
+    item_destination_cache &cache = destination_cache;
+    if( cache.revision != cache_revision || cache.where != where || cache.range != range ||
+        cache.fac != fac ) {
+        cache.revision = cache_revision;
+        cache.where = where;
+        cache.range = range;
+        cache.fac = fac;
+        cache.destinations.clear();
+    }
+    std::pair<itype_id, std::set<flag_id>> signature( it.typeId(), it.get_flags() );
+    const auto found = cache.destinations.find( signature );
+    if( found != cache.destinations.end() ) {
+        return found->second;
+    }
+    const zone_type_id dest = get_near_zone_type_by_category( it, where, range, fac );
+    cache.destinations.emplace( std::move( signature ), dest );
+    return dest;
+}
+
+zone_type_id zone_manager::get_near_zone_type_by_category( const item &it,
+        const tripoint_abs_ms &where, int range, const faction_id &fac ) const
+{
+    const item_category &cat = it.get_category_of_contents();
+
     if( it.has_flag( STATIC( flag_id( "FIREWOOD" ) ) ) ) {
         if( has_near( zone_type_LOOT_WOOD, where, range, fac ) ) {
             return zone_type_LOOT_WOOD;
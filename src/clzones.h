@@ -514,6 +514,7 @@ class zone_manager
     public:
         using ref_zone_data = std::reference_wrapper<zone_data>;
         using ref_const_zone_data = std::reference_wrapper<const zone_data>;
+        using zone_area = inclusive_cuboid<tripoint_abs_ms>;
 
     private:
         static const int MAX_DISTANCE = ACTIVITY_SEARCH_DISTANCE;
@@ -531,14 +532,32 @@ class zone_manager
         // a count of the number of personal zones the character has
         int num_personal_zones = 0; // NOLINT(cata-serialize)
 
+        // areas of the enabled zones by type hash, overlapping areas are kept as they are
         // NOLINTNEXTLINE(cata-serialize)
-        std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> area_cache;
+        std::unordered_map<std::string, std::vector<zone_area>> area_cache;
         // NOLINTNEXTLINE(cata-serialize)
-        std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> vzone_cache;
-        std::unordered_set<tripoint_abs_ms> get_point_set( const zone_type_id &type,
+        std::unordered_map<std::string, std::vector<zone_area>> vzone_cache;
+        // bumped whenever area_cache or vzone_cache is rebuilt
+        int cache_revision = 0; // NOLINT(cata-serialize)
+
+        // Sorting destinations of items without contents, they only depend on the item type and
+        // its own flags. Valid for one origin, range and faction at one cache_revision.
+        struct item_destination_cache {
+            int revision = -1;
+            tripoint_abs_ms where;
+            int range = 0;
+            faction_id fac;
+            std::map<std::pair<itype_id, std::set<flag_id>>, zone_type_id> destinations;
+        };
+        mutable item_destination_cache destination_cache; // NOLINT(cata-serialize)
+
+        const std::vector<zone_area> &get_point_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint_abs_ms> get_vzone_set( const zone_type_id &type,
+        const std::vector<zone_area> &get_vzone_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
+        // get_near_zone_type_for_item minus the custom and item group zones
+        zone_type_id get_near_zone_type_by_category( const item &it, const tripoint_abs_ms &where,
+                int range, const faction_id &fac ) const;
     public:
         zone_manager();
         ~zone_manager() = default;
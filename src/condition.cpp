@@ -527,8 +527,29 @@ void write_var_value( var_type type, const std::string &name, dialogue *d,
 void write_var_value( var_type type, const std::string &name, dialogue *d,
                       double value )
 {
-    // NOLINTNEXTLINE(cata-translate-string-literal)
-    write_var_value( type, name, d, string_format( "%g", value ) );
+    // Numbers stay numbers where the variable store is typed, the rest gets the text
+    switch( type ) {
+        case var_type::global:
+            get_globals().set_global_number( name, value );
+            break;
+        case var_type::u:
+            if( d->has_alpha ) {
+                d->actor( false )->set_number_value( name, value );
+            } else {
+                debugmsg( "Tried to use an invalid alpha talker.  %s", d->get_callstack() );
+            }
+            break;
+        case var_type::npc:
+            if( d->has_beta ) {
+                d->actor( true )->set_number_value( name, value );
+            } else {
+                debugmsg( "Tried to use an invalid beta talker.  %s", d->get_callstack() );
+            }
+            break;
+        default:
+            write_var_value( type, name, d, var_value( value ).str() );
+            break;
+    }
 }
 
 static bodypart_id get_bp_from_str( const std::string &ctxt )
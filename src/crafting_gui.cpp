@@ -14,6 +14,7 @@
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -64,6 +65,8 @@
 
 static const limb_score_id limb_score_manip( "manip" );
 
+static const trait_id trait_DEBUG_HS( "DEBUG_HS" );
+
 static const std::string flag_AFFECTED_BY_PAIN( "AFFECTED_BY_PAIN" );
 static const std::string flag_BLIND_EASY( "BLIND_EASY" );
 static const std::string flag_BLIND_HARD( "BLIND_HARD" );
@@ -327,6 +330,150 @@ struct availability {
             return false;
         }
 };
+
+// Items of one type in a crafting inventory, reduced to the properties recipe availability
+// depends on (amounts, charges and what the component filters look at).
+struct item_type_summary {
+    int count = 0;
+    int broken = 0;
+    int ammo = 0;
+    int usable = 0;
+    int rotten = 0;
+    int favorite = 0;
+    int frozen = 0;
+    int empty = 0;
+
+    bool operator==( const item_type_summary &rhs ) const {
+        return count == rhs.count && broken == rhs.broken && ammo == rhs.ammo &&
+               usable == rhs.usable && rotten == rhs.rotten && favorite == rhs.favorite &&
+               frozen == rhs.frozen && empty == rhs.empty;
+    }
+    bool operator!=( const item_type_summary &rhs ) const {
+        return !( *this == rhs );
+    }
+};
+
+using inventory_summary = std::unordered_map<itype_id, item_type_summary>;
+
+inventory_summary summarize_inventory( const inventory &inv )
+{
+    inventory_summary result;
+    for( const auto &[type, items] : inv.get_binned_items() ) {
+        item_type_summary &sum = result[type];
+        for( const item *it : items ) {
+            if( it->has_flag( flag_ITEM_BROKEN ) ) {
+                sum.broken++;
+            } else {
+                sum.count += it->count();
+            }
+            sum.ammo += it->ammo_remaining();
+            sum.usable += is_crafting_component( *it ) ? 1 : 0;
+            sum.rotten += it->rotten() ? 1 : 0;
+            sum.favorite += it->is_favorite ? 1 : 0;
+            sum.frozen += it->has_flag( flag_FROZEN ) ? 1 : 0;
+            sum.empty += it->empty_container() ? 1 : 0;
+        }
+    }
+    return result;
+}
+
+// What recipe availability depends on apart from the crafting inventory.
+struct crafter_state {
+    explicit crafter_state( const Character &crafter ) {
+        for( const Skill &sk : Skill::skills ) {
+            skill_levels.push_back( crafter.get_skill_level( sk.ident() ) );
+            knowledge_levels.push_back( crafter.get_knowledge_level( sk.ident() ) );
+        }
+        for( const Character *guy : crafter.get_crafting_group() ) {
+            group_proficiencies.emplace_back( guy->getID(), guy->known_proficiencies() );
+        }
+        debug_hs = get_player_character().has_trait( trait_DEBUG_HS );
+    }
+
+    bool operator==( const crafter_state &rhs ) const {
+        return skill_levels == rhs.skill_levels && knowledge_levels == rhs.knowledge_levels &&
+               group_proficiencies == rhs.group_proficiencies && debug_hs == rhs.debug_hs;
+    }
+
+    std::vector<float> skill_levels;
+    std::vector<int> knowledge_levels;
+    std::vector<std::pair<character_id, std::vector<proficiency_id>>> group_proficiencies;
+    bool debug_hs = false;
+};
+
+// Availability of recipes for one crafter, kept between openings of the crafting menu.
+struct availability_memory {
+    const Character *crafter = nullptr;
+    int recipe_generation = -1;
+    std::optional<crafter_state> state;
+    inventory_summary inventory;
+    std::map<const recipe *, availability> cache;
+};
+
+/**
+ * Returns the availability cache of @p crafter from the previous time the menu was open,
+ * with the entries that may have changed since then removed.
+ * Those are found by comparing summaries of the crafting inventory and looking up the
+ * recipes that use the changed item types, or the qualities they provide.
+ */
+std::map<const recipe *, availability> &remembered_availability( Character &crafter )
+{
+    static std::map<character_id, availability_memory> memories;
+    availability_memory &memory = memories[crafter.getID()];
+
+    crafter_state state( crafter );
+    inventory_summary inv = summarize_inventory( crafter.crafting_inventory() );
+    if( memory.crafter != &crafter || memory.recipe_generation != recipe_dict.get_generation() ||
+        !memory.state || !( *memory.state == state ) ) {
+        memory.cache.clear();
+    } else {
+        std::vector<itype_id> changed;
+        for( const auto &[type, sum] : inv ) {
+            const auto old = memory.inventory.find( type );
+            if( old == memory.inventory.end() || old->second != sum ) {
+                changed.push_back( type );
+            }
+        }
+        for( const auto &[type, sum] : memory.inventory ) {
+            if( inv.count( type ) == 0 ) {
+                changed.push_back( type );
+            }
+        }
+        bool changed_ups = false;
+        std::set<const recipe *> stale;
+        for( const itype_id &type : changed ) {
+            const std::set<const recipe *> &users = recipe_dict.recipes_using_item( type );
+            stale.insert( users.begin(), users.end() );
+            for( const auto &qual : type->qualities ) {
+                const std::set<const recipe *> &qual_users = recipe_dict.recipes_using_quality( qual.first );
+                stale.insert( qual_users.begin(), qual_users.end() );
+            }
+            for( const auto &qual : type->charged_qualities ) {
+                const std::set<const recipe *> &qual_users = recipe_dict.recipes_using_quality( qual.first );
+                stale.insert( qual_users.begin(), qual_users.end() );
+            }
+            changed_ups = changed_ups || type->has_flag( flag_IS_UPS );
+        }
+        if( changed_ups ) {
+            // UPS charges stand in for the charges of many tools, don't try to track that
+            memory.cache.clear();
+        } else {
+            for( const recipe *r : stale ) {
+                memory.cache.erase( r );
+            }
+            // Nested categories depend on the recipes in them, they are cheap to check again.
+            for( const recipe *r : recipe_dict.all_nested() ) {
+                memory.cache.erase( r );
+            }
+        }
+    }
+
+    memory.crafter = &crafter;
+    memory.recipe_generation = recipe_dict.get_generation();
+    memory.state.emplace( std::move( state ) );
+    memory.inventory = std::move( inv );
+    return memory.cache;
+}
 } // namespace
 
 static std::string craft_success_chance_string( const recipe &recp, const Character &guy )
@@ -1314,10 +1461,7 @@ std::pair<Character *, const recipe *> select_crafter_and_crafting_recipe( int &
 
     // Get everyone's recipes
     const recipe_subset &available_recipes = crafter->get_group_available_recipes();
-    std::map<character_id, std::map<const recipe *, availability>> guy_availability_cache;
-    // next line also inserts empty cache for crafter->getID()
-    std::map<const recipe *, availability> *availability_cache =
-        &guy_availability_cache[crafter->getID()];
+    std::map<const recipe *, availability> *availability_cache = &remembered_availability( *crafter );
 
     const std::string new_recipe_str = pgettext( "crafting gui", "NEW!" );
     const nc_color new_recipe_str_col = c_light_green;
@@ -1921,8 +2065,7 @@ std::pair<Character *, const recipe *> select_crafter_and_crafting_recipe( int &
             if( new_crafter_i >= 0 && new_crafter_i != crafter_i ) {
                 crafter_i = new_crafter_i;
                 crafter = crafting_group[crafter_i];
-                // next line also inserts empty cache for crafter->getID() if non existant
-                availability_cache = &guy_availability_cache[crafter->getID()];
+                availability_cache = &remembered_availability( *crafter );
                 recalc = true;
                 keepline = true;
             }
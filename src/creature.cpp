@@ -1980,8 +1980,8 @@ void Creature::process_effects()
                 on_effect_int_change( e.get_id(), e.get_intensity(), e.get_bp() );
             }
 
-            const bool reduced = resists_effect( e );
-            if( e.kill_roll( reduced ) ) {
+            // Most effects can't kill, don't look up resistances for those every turn
+            if( e.can_kill() && e.kill_roll( resists_effect( e ) ) ) {
                 add_msg_if_player( m_bad, e.get_death_message() );
                 if( is_avatar() ) {
                     std::map<std::string, cata_variant> event_data;
@@ -2025,12 +2025,17 @@ bool Creature::has_trait( const trait_id &/*flag*/ ) const
 // Methods for setting/getting misc key/value pairs.
 void Creature::set_value( const std::string &key, const std::string &value )
 {
-    values[ key ] = value;
+    values.set( key, value );
+}
+
+void Creature::set_number_value( const std::string &key, double value )
+{
+    values.set( key, value );
 }
 
 void Creature::remove_value( const std::string &key )
 {
-    values.erase( key );
+    values.remove( key );
 }
 
 std::string Creature::get_value( const std::string &key ) const
@@ -2040,8 +2045,12 @@ std::string Creature::get_value( const std::string &key ) const
 
 std::optional<std::string> Creature::maybe_get_value( const std::string &key ) const
 {
-    auto it = values.find( key );
-    return it == values.end() ? std::nullopt : std::optional<std::string> { it->second };
+    return values.maybe_get( key );
+}
+
+std::optional<double> Creature::maybe_get_number_value( const std::string &key ) const
+{
+    return values.maybe_get_number( key );
 }
 
 void Creature::clear_values()
@@ -3092,7 +3101,7 @@ bool Creature::is_symbol_highlighted() const
     return false;
 }
 
-std::unordered_map<std::string, std::string> &Creature::get_values()
+const var_store &Creature::get_values() const
 {
     return values;
 }
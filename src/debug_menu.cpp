@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "achievement.h"
+#include "active_item_cache.h"
 #include "action.h"
 #include "activity_tracker.h"
 #include "avatar.h"
@@ -130,6 +131,7 @@
 #include "weather_gen.h"
 #include "weather_type.h"
 #include "weighted_list.h"
+#include "world_backup.h"
 #include "worldfactory.h"
 
 static const achievement_id achievement_achievement_arcade_mode( "achievement_arcade_mode" );
@@ -243,6 +245,8 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
         case debug_menu::debug_menu_index::SAVE_SCREENSHOT: return "SAVE_SCREENSHOT";
         case debug_menu::debug_menu_index::GAME_REPORT: return "GAME_REPORT";
         case debug_menu::debug_menu_index::GAME_MIN_ARCHIVE: return "GAME_MIN_ARCHIVE";
+        case debug_menu::debug_menu_index::GAME_BACKUP: return "GAME_BACKUP";
+        case debug_menu::debug_menu_index::GAME_RESTORE_BACKUP: return "GAME_RESTORE_BACKUP";
         case debug_menu::debug_menu_index::DISPLAY_SCENTS_LOCAL: return "DISPLAY_SCENTS_LOCAL";
         case debug_menu::debug_menu_index::DISPLAY_SCENTS_TYPE_LOCAL: return "DISPLAY_SCENTS_TYPE_LOCAL";
         case debug_menu::debug_menu_index::DISPLAY_TEMP: return "DISPLAY_TEMP";
@@ -269,6 +273,7 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
 		case debug_menu::debug_menu_index::SIX_MILLION_DOLLAR_SURVIVOR: return "SIX_MILLION_DOLLAR_SURVIVOR";
 		case debug_menu::debug_menu_index::EDIT_FACTION: return "EDIT_FACTION";
 		case debug_menu::debug_menu_index::WRITE_CITY_LIST: return "WRITE_CITY_LIST";
+		case debug_menu::debug_menu_index::WRITE_ACTIVE_ITEM_STATS: return "WRITE_ACTIVE_ITEM_STATS";
         // *INDENT-ON*
         case debug_menu::debug_menu_index::last:
             break;
@@ -415,6 +420,48 @@ void write_min_archive()
     }
 }
 
+void backup_world()
+{
+    fs::path const save_root( PATH_INFO::world_base_save_path_path() );
+    fs::path const store = world_backup::store_for( save_root );
+    std::string error;
+    if( std::optional<std::string> snapshot = world_backup::create( save_root, store, error ) ) {
+        popup( string_format( _( "Backup %1$s saved to %2$s" ), *snapshot, store.u8string() ) );
+    } else {
+        popup( string_format( _( "Backing up the world failed: %s" ), error ) );
+    }
+}
+
+void restore_world_backup()
+{
+    fs::path const save_root( PATH_INFO::world_base_save_path_path() );
+    fs::path const store = world_backup::store_for( save_root );
+    std::vector<std::string> const snapshots = world_backup::snapshots( store );
+    if( snapshots.empty() ) {
+        popup( _( "This world has no backups yet." ) );
+        return;
+    }
+    uilist menu;
+    menu.text = _( "Restore which backup?" );
+    for( size_t i = 0; i < snapshots.size(); ++i ) {
+        menu.addentry( static_cast<int>( i ), true, MENU_AUTOASSIGN, snapshots[i] );
+    }
+    menu.query();
+    if( menu.ret < 0 || static_cast<size_t>( menu.ret ) >= snapshots.size() ) {
+        return;
+    }
+    // Never over the running world, the restored one shows up as a world of its own.
+    std::string const &snapshot = snapshots[menu.ret];
+    fs::path const target = save_root.parent_path() /
+                            fs::u8path( save_root.filename().u8string() + "-" + snapshot );
+    std::string error;
+    if( world_backup::restore( store, snapshot, target, error ) ) {
+        popup( string_format( _( "Backup restored as world \"%s\"." ), target.filename().u8string() ) );
+    } else {
+        popup( string_format( _( "Restoring the backup failed: %s" ), error ) );
+    }
+}
+
 } // namespace
 
 namespace debug_menu
@@ -716,6 +763,8 @@ static int info_uilist( bool display_all_entries = true )
         { uilist_entry( debug_menu_index::SAVE_SCREENSHOT, true, 'H', _( "Take screenshot" ) ) },
         { uilist_entry( debug_menu_index::GAME_REPORT, true, 'r', _( "Generate game report" ) ) },
         { uilist_entry( debug_menu_index::GAME_MIN_ARCHIVE, true, '!', _( "Generate minimized save archive" ) ) },
+        { uilist_entry( debug_menu_index::GAME_BACKUP, true, 'k', _( "Back up world" ) ) },
+        { uilist_entry( debug_menu_index::GAME_RESTORE_BACKUP, true, 'K', _( "Restore world backup" ) ) },
     };
 
     if( display_all_entries ) {
@@ -750,6 +799,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( debug_menu_index::TEST_MAP_EXTRA_DISTRIBUTION, true, 'e', _( "Test map extra list" ) ) },
             { uilist_entry( debug_menu_index::GENERATE_EFFECT_LIST, true, 'L', _( "Generate effect list" ) ) },
             { uilist_entry( debug_menu_index::WRITE_CITY_LIST, true, 'C', _( "Write city list to cities.output" ) ) },
+            { uilist_entry( debug_menu_index::WRITE_ACTIVE_ITEM_STATS, true, 'I', _( "Write active item processing statistics to active_items.output" ) ) },
         };
         uilist_initializer.insert( uilist_initializer.begin(), debug_only_options.begin(),
                                    debug_only_options.end() );
@@ -2488,7 +2538,7 @@ static void character_edit_menu()
                 testfile << "|;key;value;" << std::endl;
 
                 for( const auto &value : you.get_values() ) {
-                    testfile << "|;" << value.first << ";" << value.second << ";" << std::endl;
+                    testfile << "|;" << value.first << ";" << value.second.str() << ";" << std::endl;
                 }
 
             }, "var_list" );
@@ -3579,6 +3629,28 @@ static void write_city_list()
     popup( string_format( _( "city list written to cities.output" ) ) );
 }
 
+static void write_active_item_stats()
+{
+    write_to_file( "active_items.output", [&]( std::ostream & testfile ) {
+        std::vector<std::pair<itype_id, active_item_stats::entry>> sorted(
+                    active_item_stats::get().begin(), active_item_stats::get().end() );
+        std::sort( sorted.begin(), sorted.end(), []( const auto & lhs, const auto & rhs ) {
+            return lhs.second.total > rhs.second.total;
+        } );
+        testfile << "id;calls;destroyed;total_us;average_us" << std::endl;
+        for( const std::pair<itype_id, active_item_stats::entry> &stat : sorted ) {
+            const long long total_us = std::chrono::duration_cast<std::chrono::microseconds>
+                                       ( stat.second.total ).count();
+            testfile << stat.first.str() << ";" << stat.second.calls << ";" << stat.second.destroyed
+                     << ";" << total_us << ";" << total_us / std::max( stat.second.calls, 1 ) << std::endl;
+        }
+    }, "active item statistics" );
+
+    if( query_yn( _( "Statistics written to active_items.output.  Reset them?" ) ) ) {
+        active_item_stats::reset();
+    }
+}
+
 static void write_global_vars()
 {
     write_to_file( "var_list.output", [&]( std::ostream & testfile ) {
@@ -3607,6 +3679,8 @@ void debug()
         debug_menu_index::SAVE_SCREENSHOT,
         debug_menu_index::GAME_REPORT,
         debug_menu_index::GAME_MIN_ARCHIVE,
+        debug_menu_index::GAME_BACKUP,
+        debug_menu_index::GAME_RESTORE_BACKUP,
         debug_menu_index::ENABLE_ACHIEVEMENTS,
         debug_menu_index::UNLOCK_ALL,
         debug_menu_index::BENCHMARK,
@@ -4022,6 +4096,20 @@ void debug()
             write_min_archive();
             break;
         }
+        case debug_menu_index::GAME_BACKUP: {
+            g->quicksave();
+
+            static_popup popup;
+            popup.message( "%s", _( "Backing up world, this may take a while." ) );
+            ui_manager::redraw();
+            refresh_display();
+
+            backup_world();
+            break;
+        }
+        case debug_menu_index::GAME_RESTORE_BACKUP:
+            restore_world_backup();
+            break;
         case debug_menu_index::CHANGE_SPELLS:
             change_spells( player_character );
             break;
@@ -4119,6 +4207,10 @@ void debug()
             faction_edit_menu();
             break;
 
+        case debug_menu_index::WRITE_ACTIVE_ITEM_STATS:
+            write_active_item_stats();
+            break;
+
         case debug_menu_index::WRITE_CITY_LIST:
             write_city_list();
 
@@ -81,6 +81,8 @@ enum class debug_menu_index : int {
     SAVE_SCREENSHOT,
     GAME_REPORT,
     GAME_MIN_ARCHIVE,
+    GAME_BACKUP,
+    GAME_RESTORE_BACKUP,
     DISPLAY_SCENTS_LOCAL,
     DISPLAY_SCENTS_TYPE_LOCAL,
     DISPLAY_TEMP,
@@ -112,6 +114,7 @@ enum class debug_menu_index : int {
     SIX_MILLION_DOLLAR_SURVIVOR,
     EDIT_FACTION,
     WRITE_CITY_LIST,
+    WRITE_ACTIVE_ITEM_STATS,
     last
 };
 
@@ -0,0 +1,239 @@
+#include "deferred_writes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <ios>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "cached_options.h"
+#include "cata_path.h"
+#include "debug.h"
+#include "gzip_ostream.h"
+#include "json_loader.h"
+#include "ofstream_wrapper.h"
+#include "output.h"
+#include "string_formatter.h"
+#include "translations.h"
+
+namespace
+{
+
+struct pending_write {
+    fs::path path;
+    std::string contents;
+    std::string description;
+    /** gzip level to compress the file with on the writer thread, 0 to write it as is */
+    int compression_level = 0;
+    /** Set for save files, whose flexbuffer the writer thread caches too */
+    std::optional<cata_path> save_file;
+};
+
+struct failed_write {
+    fs::path path;
+    std::string description;
+    std::string error;
+};
+
+void write_now( const pending_write &w )
+{
+    if( w.save_file ) {
+        json_loader::invalidate_save_cache( *w.save_file );
+    }
+    // Any of the below may throw. ofstream_wrapper will clean up the temporary path on its own.
+    ofstream_wrapper fout( w.path, std::ios::binary );
+    if( w.compression_level > 0 ) {
+        gzip_ostream zout( fout.stream(), w.compression_level );
+        zout.write( w.contents.data(), w.contents.size() );
+        zout.finish();
+    } else {
+        fout.stream().write( w.contents.data(), w.contents.size() );
+    }
+    fout.close();
+    if( w.save_file ) {
+        // The contents are at hand already, parsing them here saves the next load doing it.
+        json_loader::update_save_cache( *w.save_file, w.contents );
+    }
+}
+
+/**
+ * The writer thread and its queue. The thread is started with the first queued file and runs
+ * until program exit, where it finishes the queue before being joined.
+ */
+class writer
+{
+    public:
+        writer() = default;
+        writer( const writer & ) = delete;
+        writer &operator=( const writer & ) = delete;
+
+        ~writer() {
+            if( !thread.joinable() ) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            work_available.notify_one();
+            thread.join();
+        }
+
+        void enqueue( pending_write &&w ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            if( !thread.joinable() ) {
+                try {
+                    thread = std::thread( [this]() {
+                        run();
+                    } );
+                } catch( const std::system_error & ) {
+                    // No thread, no problem: write it right here like write_to_file would.
+                    lock.unlock();
+                    write_now( w );
+                    return;
+                }
+            }
+            queue.emplace_back( std::move( w ) );
+            pending = true;
+            lock.unlock();
+            work_available.notify_one();
+        }
+
+        void wait() {
+            if( !pending ) {
+                return;
+            }
+            std::unique_lock<std::mutex> lock( mutex );
+            idle.wait( lock, [this]() {
+                return queue.empty() && !busy;
+            } );
+        }
+
+        std::vector<failed_write> take_failures() {
+            std::lock_guard<std::mutex> lock( mutex );
+            return std::exchange( failures, {} );
+        }
+
+    private:
+        void run() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                work_available.wait( lock, [this]() {
+                    return stopping || !queue.empty();
+                } );
+                if( queue.empty() ) {
+                    return;
+                }
+                pending_write w = std::move( queue.front() );
+                queue.pop_front();
+                busy = true;
+                lock.unlock();
+
+                std::string error;
+                try {
+                    write_now( w );
+                } catch( const std::exception &err ) {
+                    error = err.what();
+                }
+
+                lock.lock();
+                busy = false;
+                if( !error.empty() ) {
+                    failures.push_back( { std::move( w.path ), std::move( w.description ),
+                                          std::move( error ) } );
+                }
+                if( queue.empty() ) {
+                    pending = false;
+                    idle.notify_all();
+                }
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable idle;
+        std::deque<pending_write> queue;
+        std::vector<failed_write> failures;
+        /** Set while something is queued or being written, lets @ref wait skip the lock */
+        std::atomic<bool> pending{ false };
+        bool busy = false;
+        bool stopping = false;
+        std::thread thread;
+};
+
+writer &get_writer()
+{
+    static writer the_writer;
+    return the_writer;
+}
+
+int scope_depth = 0;
+
+} // namespace
+
+namespace deferred_writes
+{
+
+scope::scope()
+{
+    ++scope_depth;
+}
+
+scope::~scope()
+{
+    --scope_depth;
+}
+
+bool active()
+{
+#if defined(EMSCRIPTEN)
+    // No threads to hand the writes to.
+    return false;
+#else
+    return scope_depth > 0;
+#endif
+}
+
+void enqueue( const fs::path &path, std::string &&contents, const char *description,
+              int compression_level, const cata_path *save_file )
+{
+    get_writer().enqueue( { path, std::move( contents ), description ? description : "",
+                            compression_level,
+                            save_file ? std::optional<cata_path>( *save_file ) : std::nullopt } );
+}
+
+void wait()
+{
+    get_writer().wait();
+}
+
+bool finish()
+{
+    wait();
+    const std::vector<failed_write> failures = get_writer().take_failures();
+    for( const failed_write &f : failures ) {
+        const std::string msg =
+            string_format( _( "Failed to write %1$s to \"%2$s\": %3$s" ),
+                           f.description.empty() ? _( "save data" ) : f.description,
+                           f.path.generic_u8string(), f.error );
+        if( test_mode ) {
+            DebugLog( D_ERROR, DC_ALL ) << msg;
+        } else {
+            popup( "%s", msg );
+        }
+    }
+    return failures.empty();
+}
+
+} // namespace deferred_writes
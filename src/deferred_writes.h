@@ -0,0 +1,61 @@
+#pragma once
+#ifndef CATA_SRC_DEFERRED_WRITES_H
+#define CATA_SRC_DEFERRED_WRITES_H
+
+#include <string>
+
+#include "filesystem.h"
+
+class cata_path;
+
+/**
+ * Moves the disk I/O of saving off the main thread.
+ *
+ * While a @ref deferred_writes::scope is alive, @ref write_to_file only serializes into memory
+ * and queues the result. A single writer thread then writes the queued files in order, each
+ * one atomically through @ref ofstream_wrapper (temporary file + rename).
+ *
+ * Anything that reads save files (@ref file_exist, @ref read_from_file and friends) waits for
+ * the queue to drain first, so a submap or overmap that was saved and dropped from memory can
+ * be loaded again right away.
+ */
+namespace deferred_writes
+{
+
+/** Queues writes made by @ref write_to_file on the calling (main) thread while it is alive. */
+class scope
+{
+    public:
+        scope();
+        ~scope();
+        scope( const scope & ) = delete;
+        scope &operator=( const scope & ) = delete;
+};
+
+/** Whether @ref write_to_file should queue instead of writing, i.e. a @ref scope is alive. */
+bool active();
+
+/**
+ * Hands @p contents to the writer thread to be written to @p path.
+ * @param description What is being written, used when reporting a failure.
+ * @param compression_level If above 0, the writer thread gzip-compresses @p contents at this
+ * level on the way to disk.
+ * @param save_file If set, @p path is this save file, and the writer thread keeps its cached
+ * flexbuffer in step (see @ref json_loader::update_save_cache).
+ */
+void enqueue( const fs::path &path, std::string &&contents, const char *description,
+              int compression_level = 0, const cata_path *save_file = nullptr );
+
+/** Blocks until every queued file has been written. Cheap if nothing is queued. */
+void wait();
+
+/**
+ * The barrier before the next save or quit: waits like @ref wait and reports any write that
+ * failed since the last call.
+ * @return false if some write failed.
+ */
+bool finish();
+
+} // namespace deferred_writes
+
+#endif // CATA_SRC_DEFERRED_WRITES_H
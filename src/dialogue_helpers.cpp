@@ -39,6 +39,32 @@ std::optional<std::string> maybe_read_var_value(
     return std::nullopt;
 }
 
+std::optional<double> maybe_read_var_number( const var_info &info, const dialogue &d,
+        int call_depth )
+{
+    switch( info.type ) {
+        case var_type::global:
+            return get_globals().maybe_get_global_number( info.name );
+        case var_type::u:
+            return d.actor( false )->maybe_get_number_value( info.name );
+        case var_type::npc:
+            return d.actor( true )->maybe_get_number_value( info.name );
+        case var_type::var: {
+            std::optional<std::string> const var_val = d.maybe_get_value( info.name );
+            if( !var_val || call_depth > 1000 ) {
+                return std::nullopt;
+            }
+            return maybe_read_var_number( process_variable( *var_val ), d, call_depth + 1 );
+        }
+        case var_type::context:
+        case var_type::faction:
+        case var_type::party:
+        case var_type::last:
+            return std::nullopt;
+    }
+    return std::nullopt;
+}
+
 template
 std::optional<std::string> maybe_read_var_value( const var_info &, const dialogue &,
         int call_depth );
@@ -92,6 +92,12 @@ std::string read_var_value( const abstract_var_info<T> &info, const dialogue &d
 template<class T>
 std::optional<std::string> maybe_read_var_value(
     const abstract_var_info<T> &info, const dialogue &d, int call_depth = 0 );
+/**
+ * Reads a variable that is stored as a number without going through its text.
+ * std::nullopt if it's unset or not a number, maybe_read_var_value() has the final say then.
+ */
+std::optional<double> maybe_read_var_number( const var_info &info, const dialogue &d,
+        int call_depth = 0 );
 
 var_info process_variable( const std::string &type );
 
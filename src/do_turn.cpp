@@ -27,6 +27,7 @@
 #include "clzones.h"
 #include "coordinates.h"
 #include "debug.h"
+#include "deferred_writes.h"
 #include "enums.h"
 #include "event.h"
 #include "event_bus.h"
@@ -102,6 +103,8 @@ namespace turn_handler
 {
 bool cleanup_at_end()
 {
+    // Make sure the last autosave is on disk before the save is moved or the game unloaded.
+    deferred_writes::finish();
     avatar &u = get_avatar();
     if( g->uquit == QUIT_DIED || g->uquit == QUIT_SUICIDE ) {
         // Put (non-hallucinations) into the overmap so they are not lost.
@@ -391,13 +394,14 @@ void overmap_npc_move()
     avatar &u = get_avatar();
     std::vector<npc *> travelling_npcs;
     static constexpr int move_search_radius = 600;
-    for( auto &elem : overmap_buffer.get_npcs_near_player( move_search_radius ) ) {
+    // Only the travelling ones, which leaves the other npcs of the area dormant.
+    for( auto &elem : overmap_buffer.get_npcs_near_player( move_search_radius,
+            NPC_MISSION_TRAVELLING ) ) {
         if( !elem ) {
             continue;
         }
         npc *npc_to_add = elem.get();
-        if( ( !npc_to_add->is_active() || rl_dist( u.pos(), npc_to_add->pos() ) > SEEX * 2 ) &&
-            npc_to_add->mission == NPC_MISSION_TRAVELLING ) {
+        if( !npc_to_add->is_active() || rl_dist( u.pos(), npc_to_add->pos() ) > SEEX * 2 ) {
             travelling_npcs.push_back( npc_to_add );
         }
     }
@@ -498,6 +502,11 @@ bool do_turn()
         overmap_buffer.process_mongroups();
     }
 
+    // Create the overmap the player is heading towards before the map needs it.
+    if( calendar::once_every( 1_minutes ) ) {
+        overmap_buffer.prepare_neighbors( u.global_omt_location() );
+    }
+
     // Move hordes every 2.5 min
     if( calendar::once_every( time_duration::from_minutes( 2.5 ) ) ) {
 
@@ -1625,6 +1625,11 @@ std::vector<effect_dur_mod> effect::get_effect_dur_scaling() const
     return eff_type->effect_dur_scaling;
 }
 
+bool effect::can_kill() const
+{
+    return !eff_type->kill_chance.empty() || !eff_type->red_kill_chance.empty();
+}
+
 bool effect::kill_roll( bool reduced ) const
 {
     const std::vector<std::pair<int, int>> &chances = reduced ? eff_type->red_kill_chance :
@@ -391,6 +391,8 @@ class effect
 
         std::vector<effect_dur_mod> get_effect_dur_scaling() const;
 
+        /** Returns true if kill_roll() can ever succeed for this effect */
+        bool can_kill() const;
         bool kill_roll( bool reduced ) const;
         std::string get_death_message() const;
         event_type death_event() const;
@@ -1,6 +1,7 @@
 #include "effect_on_condition.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <list>
 #include <ostream>
@@ -229,43 +230,83 @@ void effect_on_conditions::queue_effect_on_condition( time_duration duration,
     }
 }
 
+namespace
+{
+/** Accumulated evaluation cost of an eoc run by the scheduler or by events */
+struct eoc_cost {
+    int evaluations = 0;
+    std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero();
+};
+std::unordered_map<effect_on_condition_id, eoc_cost> eoc_costs;
+} // namespace
+
+static bool activate_measured( const effect_on_condition &eoc, dialogue &d )
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const bool activated = eoc.activate( d );
+    eoc_cost &cost = eoc_costs[eoc.id];
+    cost.evaluations++;
+    cost.total += std::chrono::steady_clock::now() - start;
+    return activated;
+}
+
+static void write_eoc_costs( std::ostream &testfile )
+{
+    std::vector<std::pair<effect_on_condition_id, eoc_cost>> sorted( eoc_costs.begin(),
+            eoc_costs.end() );
+    std::sort( sorted.begin(), sorted.end(), []( const auto & lhs, const auto & rhs ) {
+        return lhs.second.total > rhs.second.total;
+    } );
+    testfile << "evaluation cost:" << std::endl;
+    testfile << "id;evaluations;total_us;average_us" << std::endl;
+    for( const std::pair<effect_on_condition_id, eoc_cost> &entry : sorted ) {
+        const long long total_us = std::chrono::duration_cast<std::chrono::microseconds>
+                                   ( entry.second.total ).count();
+        testfile << entry.first.c_str() << ";" << entry.second.evaluations << ";" << total_us << ";"
+                 << total_us / std::max( entry.second.evaluations, 1 ) << std::endl;
+    }
+}
+
 static void process_eocs( queued_eocs &eoc_queue, std::vector<effect_on_condition_id> &eoc_vector,
                           dialogue &d )
 {
     static std::vector<queued_eocs::storage_iter> eocs_to_queue;
     eocs_to_queue.clear();
 
-    while( !eoc_queue.empty() &&
-           eoc_queue.top().time <= calendar::turn ) {
-        queued_eocs::storage_iter it = eoc_queue.queue.top();
-        queued_eoc &top = *it;
-        eoc_queue.queue.pop();
-
-        dialogue nested_d{ d };
-        for( const auto &val : top.context ) {
-            nested_d.set_value( val.first, val.second );
-        }
-        bool activated = top.eoc->activate( nested_d );
-        if( top.eoc->type == eoc_type::RECURRING ) {
-            if( activated ) { // It worked so add it back
-                it->time = calendar::turn + next_recurrence( top.eoc, d );
-                eocs_to_queue.emplace_back( it );
-            } else {
-                if( !top.eoc->check_deactivate(
-                        nested_d ) ) { // It failed but shouldn't be deactivated so add it back
+    // Eocs queued while processing with no delay land in a new due bucket, so keep taking
+    // buckets until none is due; recurring ones are rescheduled afterwards so they can't loop.
+    for( std::vector<queued_eocs::storage_iter> due = eoc_queue.take_due( calendar::turn );
+         !due.empty(); due = eoc_queue.take_due( calendar::turn ) ) {
+        for( queued_eocs::storage_iter &it : due ) {
+            queued_eoc &top = *it;
+            const effect_on_condition &eoc = top.eoc.obj();
+
+            dialogue nested_d{ d };
+            for( const auto &val : top.context ) {
+                nested_d.set_value( val.first, val.second );
+            }
+            bool activated = activate_measured( eoc, nested_d );
+            if( eoc.type == eoc_type::RECURRING ) {
+                if( activated ) { // It worked so add it back
                     it->time = calendar::turn + next_recurrence( top.eoc, d );
                     eocs_to_queue.emplace_back( it );
-                } else { // It failed and should be deactivated for now
-                    eoc_vector.push_back( top.eoc );
-                    eoc_queue.list.erase( it );
+                } else {
+                    if( !eoc.check_deactivate(
+                            nested_d ) ) { // It failed but shouldn't be deactivated so add it back
+                        it->time = calendar::turn + next_recurrence( top.eoc, d );
+                        eocs_to_queue.emplace_back( it );
+                    } else { // It failed and should be deactivated for now
+                        eoc_vector.push_back( top.eoc );
+                        eoc_queue.list.erase( it );
+                    }
                 }
+            } else {
+                eoc_queue.list.erase( it );
             }
-        } else {
-            eoc_queue.list.erase( it );
         }
     }
     for( queued_eocs::storage_iter &q_eoc : eocs_to_queue ) {
-        eoc_queue.queue.emplace( q_eoc );
+        eoc_queue.schedule( q_eoc );
     }
 }
 
@@ -403,6 +444,7 @@ void effect_on_conditions::write_eocs_to_file( Character &you )
             testfile << eoc.c_str() << std::endl;
         }
 
+        write_eoc_costs( testfile );
     }, "eocs test file" );
 }
 
@@ -433,6 +475,7 @@ void effect_on_conditions::write_global_eocs_to_file( )
             testfile << eoc.c_str() << std::endl;
         }
 
+        write_eoc_costs( testfile );
     }, "eocs test file" );
 }
 
@@ -502,6 +545,7 @@ const std::vector<effect_on_condition> &effect_on_conditions::get_all()
 void effect_on_conditions::reset()
 {
     effect_on_condition_factory.reset();
+    eoc_costs.clear();
 }
 
 void effect_on_conditions::load( const JsonObject &jo, const std::string &src )
@@ -524,57 +568,55 @@ void eoc_events::notify( const cata::event &e, std::unique_ptr<talker> alpha,
                          std::unique_ptr<talker> beta )
 {
     if( !has_cached ) {
-
-        // initialize all events to an empty vector
-        for( event_type et = static_cast<event_type>( 0 ); et < event_type::num_event_types;
-             et = static_cast<event_type>( static_cast<size_t>( et ) + 1 ) ) {
-
-            event_EOCs[et] = std::vector<effect_on_condition>();
-        }
+        event_EOCs.assign( static_cast<size_t>( event_type::num_event_types ), {} );
 
         //create a cache for the specific types of EOC's so they aren't constantly all itterated through
         for( const effect_on_condition &eoc : effect_on_conditions::get_all() ) {
             if( eoc.type == eoc_type::EVENT ) {
-                event_EOCs[eoc.required_event].emplace_back( eoc );
+                event_EOCs[static_cast<size_t>( eoc.required_event )].emplace_back( eoc.id );
             }
         }
 
         has_cached = true;
     }
 
-    for( const effect_on_condition &eoc : event_EOCs[e.type()] ) {
-        if( !alpha ) {
-            // try to assign a character for the EOC
-            // TODO: refactor event_spec to take consistent inputs
-            npc *alpha_talker = nullptr;
-            const std::vector<std::string> potential_alphas = { "avatar_id", "character", "attacker", "killer", "npc" };
-            for( const std::string &potential_key : potential_alphas ) {
-                cata_variant cv = e.get_variant_or_void( potential_key );
-                if( cv != cata_variant() ) {
-                    character_id potential_id = cv.get<cata_variant_type::character_id>();
-                    if( potential_id.is_valid() ) {
-                        alpha_talker = g->find_npc( potential_id );
-                        // if we find a successful entry exit early
-                        break;
-                    }
+    const std::vector<effect_on_condition_id> &eocs = event_EOCs[static_cast<size_t>( e.type() )];
+    if( eocs.empty() ) {
+        return;
+    }
+
+    if( !alpha ) {
+        // try to assign a character for the EOC
+        // TODO: refactor event_spec to take consistent inputs
+        npc *alpha_talker = nullptr;
+        const std::vector<std::string> potential_alphas = { "avatar_id", "character", "attacker", "killer", "npc" };
+        for( const std::string &potential_key : potential_alphas ) {
+            cata_variant cv = e.get_variant_or_void( potential_key );
+            if( cv != cata_variant() ) {
+                character_id potential_id = cv.get<cata_variant_type::character_id>();
+                if( potential_id.is_valid() ) {
+                    alpha_talker = g->find_npc( potential_id );
+                    // if we find a successful entry exit early
+                    break;
                 }
             }
-            if( alpha_talker ) {
-                alpha = get_talker_for( alpha_talker );
-            } else {
-                alpha = get_talker_for( get_avatar() );
-            }
         }
-        dialogue d;
-        std::unordered_map<std::string, std::string> context;
-        for( const auto &val : e.data() ) {
-            context["npctalk_var_" + val.first] = val.second.get_string();
+        if( alpha_talker ) {
+            alpha = get_talker_for( alpha_talker );
+        } else {
+            alpha = get_talker_for( get_avatar() );
         }
+    }
+    std::unordered_map<std::string, std::string> context;
+    for( const auto &val : e.data() ) {
+        context["npctalk_var_" + val.first] = val.second.get_string();
+    }
 
+    for( const effect_on_condition_id &eoc : eocs ) {
         // if we have an NPC to trigger this event for, do so,
         // otherwise fallback to having it effect the player
-        d = dialogue( alpha->clone(), beta ? beta->clone() : nullptr, {}, context );
+        dialogue d( alpha->clone(), beta ? beta->clone() : nullptr, {}, context );
 
-        eoc.activate( d );
+        activate_measured( *eoc, d );
     }
 }
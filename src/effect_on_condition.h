@@ -46,7 +46,8 @@ class eoc_events : public event_subscriber
         void clear();
 
     private:
-        std::map<event_type, std::vector<effect_on_condition>> event_EOCs;
+        /** Event eocs indexed by event_type */
+        std::vector<std::vector<effect_on_condition_id>> event_EOCs;
         bool has_cached = false;
 };
 
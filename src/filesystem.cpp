@@ -18,6 +18,7 @@
 
 #include "cata_utility.h"
 #include "debug.h"
+#include "deferred_writes.h"
 
 #if defined(_WIN32)
 #   include "platform_win.h"
@@ -119,11 +120,14 @@ bool file_exist( const std::string &path )
 
 bool file_exist( const fs::path &path )
 {
+    // A file that is still queued for writing by the last save doesn't exist yet.
+    deferred_writes::wait();
     return fs::exists( path ) && !fs::is_directory( path );
 }
 
 bool file_exist( const cata_path &path )
 {
+    deferred_writes::wait();
     const fs::path unrelative_path = path.get_unrelative_path();
     return fs::exists( unrelative_path ) && !fs::is_directory( unrelative_path );
 }
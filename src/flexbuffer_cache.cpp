@@ -4,7 +4,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <fstream>
+#include <ios>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -23,6 +25,7 @@
 #include "filesystem.h"
 #include "json.h"
 #include "mmap_file.h"
+#include "ofstream_wrapper.h"
 
 namespace
 {
@@ -237,6 +240,10 @@ class flexbuffer_disk_cache
             std::unique_ptr<flexbuffer_disk_cache> cache{ new flexbuffer_disk_cache( cache_path, root_path ) };
 
             std::string cache_path_string = cache_path.u8string();
+            if( !dir_exist( cache_path_string ) ) {
+                // Nothing cached yet, e.g. a new world.
+                return cache;
+            }
             std::vector<std::string> all_cached_flexbuffers = get_files_from_path(
                         ".fb",
                         cache_path_string,
@@ -262,8 +269,8 @@ class flexbuffer_disk_cache
                                                       mtime_str.c_str() + 1,
                                                       nullptr, 0 ) ) );
 
-                fs::path root_relative_json_path = cached_flexbuffer_path.parent_path().lexically_relative(
-                                                       cache_path ) / original_json_file_name;
+                fs::path root_relative_json_path = ( cached_flexbuffer_path.parent_path().lexically_relative(
+                                                       cache_path ) / original_json_file_name ).lexically_normal();
                 std::string root_relative_json_path_string = root_relative_json_path.u8string();
 
                 // Don't just blindly insert, we may end up in a situation with multiple flexbuffers for the same input json
@@ -301,14 +308,8 @@ class flexbuffer_disk_cache
             const fs::path &lexically_normal_json_source_path ) {
             std::shared_ptr<flexbuffer_mmap_storage> storage;
 
-            fs::path root_relative_source_path = lexically_normal_json_source_path.lexically_relative(
-                    root_path_ ).lexically_normal();
-
-            // Is there even a potential cached flexbuffer for this file.
-            auto disk_entry = cached_flexbuffers_.find( root_relative_source_path.u8string() );
-            if( disk_entry == cached_flexbuffers_.end() ) {
-                return storage;
-            }
+            fs::path root_relative_source_path = root_relative( lexically_normal_json_source_path,
+                                                 root_path_ );
 
             std::error_code ec;
             fs::file_time_type source_mtime = get_file_mtime_millis( lexically_normal_json_source_path, ec );
@@ -317,11 +318,24 @@ class flexbuffer_disk_cache
             }
 
             // Does the source file's mtime match what we cached previously
-            if( source_mtime != disk_entry->second.mtime ) {
+            auto disk_entry = cached_flexbuffers_.find( root_relative_source_path.u8string() );
+            if( disk_entry != cached_flexbuffers_.end() && source_mtime != disk_entry->second.mtime ) {
                 // Cached flexbuffer on disk is out of date, remove it.
                 remove_file( disk_entry->second.flexbuffer_path.u8string() );
                 cached_flexbuffers_.erase( disk_entry );
-                return storage;
+                disk_entry = cached_flexbuffers_.end();
+            }
+
+            if( disk_entry == cached_flexbuffers_.end() ) {
+                // Whoever wrote the file may have cached its flexbuffer since we looked,
+                // see flexbuffer_cache::store_on_disk.
+                fs::path flexbuffer_path = flexbuffer_path_for( cache_path_, root_relative_source_path,
+                                           source_mtime );
+                if( !fs::exists( flexbuffer_path, ec ) ) {
+                    return storage;
+                }
+                disk_entry = cached_flexbuffers_.emplace( root_relative_source_path.u8string(),
+                             disk_cache_entry{ std::move( flexbuffer_path ), source_mtime } ).first;
             }
 
             // Try to mmap the cached flexbuffer
@@ -339,38 +353,51 @@ class flexbuffer_disk_cache
         bool save_to_disk( const fs::path &lexically_normal_json_source_path,
                            const std::vector<uint8_t> &flexbuffer_binary ) {
             std::error_code ec;
-            std::string json_source_path_string = lexically_normal_json_source_path.u8string();
             fs::file_time_type mtime = get_file_mtime_millis( lexically_normal_json_source_path, ec );
             if( ec ) {
                 return false;
             }
 
-            int64_t mtime_ms = std::chrono::duration_cast<std::chrono::milliseconds>
-                               ( mtime.time_since_epoch() ).count();
+            fs::path root_relative_source_path = root_relative( lexically_normal_json_source_path,
+                                                 root_path_ );
+            fs::path flexbuffer_path = flexbuffer_path_for( cache_path_, root_relative_source_path, mtime );
+            if( !write_flexbuffer( flexbuffer_path, flexbuffer_binary ) ) {
+                return false;
+            }
 
-            // Doing some variable reuse to avoid copies.
-            fs::path flexbuffer_path = ( cache_path_ / lexically_normal_json_source_path.lexically_relative(
-                                             root_path_ ) ).remove_filename();
+            cached_flexbuffers_[root_relative_source_path.u8string()] = disk_cache_entry{ flexbuffer_path, mtime };
 
-            assure_dir_exist( flexbuffer_path );
+            return true;
+        }
 
-            fs::path flexbuffer_filename = lexically_normal_json_source_path.filename();
+        static fs::path root_relative( const fs::path &lexically_normal_json_source_path,
+                                       const fs::path &root_path ) {
+            return lexically_normal_json_source_path.lexically_relative( root_path ).lexically_normal();
+        }
+
+        // The file path format is <cache path>/<root relative input file>.<mtime>.fb
+        static fs::path flexbuffer_path_for( const fs::path &cache_path,
+                                             const fs::path &root_relative_json_path, fs::file_time_type mtime ) {
+            int64_t mtime_ms = std::chrono::duration_cast<std::chrono::milliseconds>
+                               ( mtime.time_since_epoch() ).count();
+            fs::path flexbuffer_filename = root_relative_json_path.filename();
             flexbuffer_filename += fs::u8path( "." + std::to_string( mtime_ms ) + ".fb" );
-            flexbuffer_path /= flexbuffer_filename;
-            std::ofstream fb( flexbuffer_path, std::ofstream::binary );
-            if( !fb.good() ) {
-                return false;
-            }
+            return cache_path / root_relative_json_path.parent_path() / flexbuffer_filename;
+        }
 
-            fb.write( reinterpret_cast<const char *>( flexbuffer_binary.data() ), flexbuffer_binary.size() );
-            if( !fb.good() ) {
+        static bool write_flexbuffer( const fs::path &flexbuffer_path,
+                                      const std::vector<uint8_t> &flexbuffer_binary ) noexcept {
+            try {
+                assure_dir_exist( flexbuffer_path.parent_path() );
+                // Through a temporary file, so whatever maps the flexbuffer never sees half of it.
+                ofstream_wrapper fb( flexbuffer_path, std::ios::binary );
+                fb.stream().write( reinterpret_cast<const char *>( flexbuffer_binary.data() ),
+                                   flexbuffer_binary.size() );
+                fb.close();
+                return true;
+            } catch( const std::exception & ) {
                 return false;
             }
-
-            fb.close();
-            cached_flexbuffers_[json_source_path_string] = disk_cache_entry{ flexbuffer_path, mtime };
-
-            return true;
         }
 
     private:
@@ -461,10 +488,9 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_and_cache(
     auto storage = std::make_shared<flexbuffer_vector_storage>( std::move( fb ) );
 
     std::error_code ec;
-    fs::file_time_type mtime = fs::last_write_time( lexically_normal_json_source_path, ec );
-    if( ec ) {
-        // Whatever.
-    }
+    // Same precision as is_stale compares with.
+    fs::file_time_type mtime = get_file_mtime_millis( lexically_normal_json_source_path, ec );
+    ( void )ec;
 
     return std::make_shared<file_flexbuffer>( std::move( storage ),
             std::move( lexically_normal_json_source_path ),
@@ -477,3 +503,44 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_buffer( std::string b
     auto storage = std::make_shared<flexbuffer_vector_storage>( std::move( fb ) );
     return std::make_shared<string_flexbuffer>( std::move( storage ), std::move( buffer ) );
 }
+
+void flexbuffer_cache::remove_on_disk( const fs::path &cache_directory,
+                                       const fs::path &root_directory,
+                                       const fs::path &lexically_normal_json_source_path ) noexcept
+{
+    std::error_code ec;
+    fs::file_time_type mtime = get_file_mtime_millis( lexically_normal_json_source_path, ec );
+    if( ec ) {
+        // No file, nothing cached for it.
+        return;
+    }
+    remove_file( flexbuffer_disk_cache::flexbuffer_path_for( cache_directory,
+                 flexbuffer_disk_cache::root_relative( lexically_normal_json_source_path, root_directory ),
+                 mtime ) );
+}
+
+bool flexbuffer_cache::store_on_disk( const fs::path &cache_directory,
+                                      const fs::path &root_directory,
+                                      const fs::path &lexically_normal_json_source_path,
+                                      const std::string &json, size_t offset ) noexcept
+{
+    if( offset >= json.size() ) {
+        return false;
+    }
+    std::vector<uint8_t> fb;
+    try {
+        fb = parse_json_to_flexbuffer_( json.c_str() + offset, nullptr );
+    } catch( const std::exception & ) {
+        // Whoever loads it gets to report that.
+        return false;
+    }
+    std::error_code ec;
+    fs::file_time_type mtime = get_file_mtime_millis( lexically_normal_json_source_path, ec );
+    if( ec ) {
+        return false;
+    }
+    return flexbuffer_disk_cache::write_flexbuffer( flexbuffer_disk_cache::flexbuffer_path_for(
+                cache_directory,
+                flexbuffer_disk_cache::root_relative( lexically_normal_json_source_path, root_directory ),
+                mtime ), fb );
+}
@@ -4,6 +4,7 @@
 
 #include <iosfwd>
 #include <memory>
+#include <string>
 #include <unordered_map>
 
 #include <flatbuffers/flexbuffers.h>
@@ -62,6 +63,20 @@ class flexbuffer_cache
 
         static shared_flexbuffer parse_buffer( std::string buffer ) noexcept( false );
 
+        // For whoever rewrites a file that a cache with the given directories reads, to keep the
+        // flexbuffers it has on disk in step. Safe to call from any thread, they don't need the
+        // cache object.
+        // Removes the flexbuffer cached for the current version of the file. Call before replacing
+        // it: where file times are coarse, the new version may get the same time as the old one.
+        static void remove_on_disk( const fs::path &cache_directory, const fs::path &root_directory,
+                                    const fs::path &lexically_normal_json_source_path ) noexcept;
+        // Caches the flexbuffer of json (from offset on), which the file was just written with, so
+        // the next parse_and_cache of it maps that instead of parsing the text.
+        // Returns whether it was cached.
+        static bool store_on_disk( const fs::path &cache_directory, const fs::path &root_directory,
+                                   const fs::path &lexically_normal_json_source_path,
+                                   const std::string &json, size_t offset ) noexcept;
+
     private:
         flexbuffer_cache( flexbuffer_cache && ) noexcept = default;
 
@@ -4,6 +4,7 @@
 #include <cstring>
 #include <istream>
 #include <optional>
+#include <sstream>
 
 #include "cata_unreachable.h"
 #include "filesystem.h"
@@ -140,6 +141,64 @@ std::string Json::str() const
     return ret;
 }
 
+template<typename Vector>
+static void write_flexbuffer_vector( JsonOut &jsout, Vector v );
+
+static void write_flexbuffer( JsonOut &jsout, const flexbuffers::Reference &json )
+{
+    // Not flexbuffers' own ToString: that one prints doubles with fixed precision and in the
+    // current locale.
+    if( json.IsMap() ) {
+        const flexbuffers::Map map = json.AsMap();
+        const flexbuffers::TypedVector keys = map.Keys();
+        const flexbuffers::Vector values = map.Values();
+        jsout.start_object();
+        for( size_t i = 0; i < keys.size(); ++i ) {
+            jsout.member( keys[i].AsKey() );
+            write_flexbuffer( jsout, values[i] );
+        }
+        jsout.end_object();
+    } else if( json.IsVector() ) {
+        write_flexbuffer_vector( jsout, json.AsVector() );
+    } else if( json.IsTypedVector() ) {
+        write_flexbuffer_vector( jsout, json.AsTypedVector() );
+    } else if( json.IsFixedTypedVector() ) {
+        write_flexbuffer_vector( jsout, json.AsFixedTypedVector() );
+    } else if( json.IsString() ) {
+        jsout.write( json.AsString().str() );
+    } else if( json.IsBool() ) {
+        jsout.write( json.AsBool() );
+    } else if( json.IsInt() ) {
+        jsout.write( json.AsInt64() );
+    } else if( json.IsUInt() ) {
+        jsout.write( json.AsUInt64() );
+    } else if( json.IsFloat() ) {
+        jsout.write( json.AsDouble() );
+    } else {
+        jsout.write_null();
+    }
+}
+
+template<typename Vector>
+static void write_flexbuffer_vector( JsonOut &jsout, Vector v )
+{
+    jsout.start_array();
+    for( size_t i = 0; i < v.size(); ++i ) {
+        write_flexbuffer( jsout, v[i] );
+    }
+    jsout.end_array();
+}
+
+std::string Json::to_json_text() const
+{
+    std::ostringstream os;
+    {
+        JsonOut jsout( os );
+        write_flexbuffer( jsout, json_ );
+    }
+    return os.str();
+}
+
 bool JsonValue::read( bool &b, bool throw_on_error ) const
 {
     if( !test_bool() ) {
@@ -94,6 +94,11 @@ class Json
         using flexbuffer = flexbuffers::Reference;
 
         std::string str() const;
+        /**
+         * This value as JSON text that reads back to the same value, e.g. to keep a part of a
+         * file around without the flexbuffer of the whole file.
+         */
+        std::string to_json_text() const;
         [[noreturn]] void throw_error( const JsonPath &path, int offset, const std::string &message ) const;
         [[noreturn]] void throw_error_after( const JsonPath &path, const std::string &message ) const;
         [[noreturn]] void string_error( const JsonPath &path, int offset,
@@ -668,6 +673,7 @@ class JsonObject : JsonWithPath
         }
 
         using Json::str;
+        using Json::to_json_text;
 
         class const_iterator;
         friend const_iterator;
@@ -77,6 +77,7 @@
 #include "cursesport.h" // IWYU pragma: keep
 #include "damage.h"
 #include "debug.h"
+#include "deferred_writes.h"
 #include "dependency_tree.h"
 #include "dialogue.h"
 #include "dialogue_chatbin.h"
@@ -3352,7 +3353,7 @@ bool game::save_player_data()
 {
     const std::string playerfile = PATH_INFO::player_base_save_path();
 
-    const bool saved_data = write_to_file( playerfile + SAVE_EXTENSION, [&]( std::ostream & fout ) {
+    const bool saved_data = write_save_file( playerfile + SAVE_EXTENSION, [&]( std::ostream & fout ) {
         serialize( fout );
     }, _( "player data" ) );
     const bool saved_map_memory = u.save_map_memory();
@@ -3479,6 +3480,8 @@ bool game::save()
             std::chrono::steady_clock::now() - time_of_last_load );
     std::chrono::seconds total_time_played = time_played_at_last_load + time_since_load;
     events().send<event_type::game_save>( time_since_load, total_time_played );
+    // The files of the previous save must be on disk before they are written again.
+    deferred_writes::finish();
     try {
         if( !save_player_data() ||
             !save_achievements() ||
@@ -13161,8 +13164,11 @@ void game::quicksave()
 
     time_t now = std::time( nullptr ); //timestamp for start of saving procedure
 
-    //perform save
-    save();
+    //perform save, only the serialization happens here, the files are written in the background
+    {
+        deferred_writes::scope deferred;
+        save();
+    }
     //Now reset counters for autosaving, so we don't immediately autosave after a quicksave or autosave.
     moves_since_last_save = 0;
     last_save_timestamp = now;
@@ -0,0 +1,103 @@
+#include "gzip_ostream.h"
+
+#include <zconf.h>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+#include "zlib.h"
+
+/** Collects output in a put area and deflates it into @ref out whenever that fills up. */
+class gzip_ostream::deflate_buffer : public std::streambuf
+{
+    public:
+        deflate_buffer( std::ostream &out, int level ) : out( out ) {
+            memset( &zs, 0, sizeof( zs ) );
+            // windowBits + 16 writes a gzip header, which is what the readers look for.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+            if( deflateInit2( &zs, level, Z_DEFLATED, MAX_WBITS | 16, 8, Z_DEFAULT_STRATEGY ) != Z_OK ) {
+#pragma GCC diagnostic pop
+                throw std::runtime_error( "deflateInit failed while compressing." );
+            }
+            setp( input.data(), input.data() + input.size() );
+        }
+        deflate_buffer( const deflate_buffer & ) = delete;
+        deflate_buffer &operator=( const deflate_buffer & ) = delete;
+
+        ~deflate_buffer() override {
+            deflateEnd( &zs );
+        }
+
+        /** @return false if zlib or the target stream failed */
+        bool finish() {
+            return deflate_input( Z_FINISH );
+        }
+
+    protected:
+        int_type overflow( int_type c ) override {
+            if( !deflate_input( Z_NO_FLUSH ) ) {
+                return traits_type::eof();
+            }
+            if( !traits_type::eq_int_type( c, traits_type::eof() ) ) {
+                *pptr() = traits_type::to_char_type( c );
+                pbump( 1 );
+            }
+            return traits_type::not_eof( c );
+        }
+
+        int sync() override {
+            // Only hands over what is buffered, a Z_SYNC_FLUSH here would cost compression on
+            // every std::endl.
+            return deflate_input( Z_NO_FLUSH ) ? 0 : -1;
+        }
+
+    private:
+        /** Deflates the put area into @ref out and empties it. */
+        bool deflate_input( int flush ) {
+            if( failed ) {
+                return false;
+            }
+            zs.next_in = reinterpret_cast<Bytef *>( pbase() );
+            zs.avail_in = static_cast<uInt>( pptr() - pbase() );
+            int ret;
+            do {
+                zs.next_out = reinterpret_cast<Bytef *>( output.data() );
+                zs.avail_out = static_cast<uInt>( output.size() );
+                ret = deflate( &zs, flush );
+                if( ret == Z_STREAM_ERROR ) {
+                    failed = true;
+                    return false;
+                }
+                out.write( output.data(), output.size() - zs.avail_out );
+                // Z_FINISH is only done once deflate reports the end of the stream.
+            } while( zs.avail_out == 0 || ( flush == Z_FINISH && ret != Z_STREAM_END ) );
+            setp( input.data(), input.data() + input.size() );
+            failed = !out;
+            return !failed;
+        }
+
+        std::ostream &out;
+        z_stream zs;
+        bool failed = false;
+        std::array<char, 64 * 1024> input;
+        std::array<char, 64 * 1024> output;
+};
+
+gzip_ostream::gzip_ostream( std::ostream &out, int level ) :
+    std::ostream( nullptr ), buffer( std::make_unique<deflate_buffer>( out, level ) )
+{
+    rdbuf( buffer.get() );
+}
+
+gzip_ostream::~gzip_ostream() = default;
+
+void gzip_ostream::finish()
+{
+    if( !*this || !buffer->finish() ) {
+        setstate( std::ios::badbit );
+        throw std::runtime_error( "compressing the file failed" );
+    }
+}
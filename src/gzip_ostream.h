@@ -0,0 +1,31 @@
+#pragma once
+#ifndef CATA_SRC_GZIP_OSTREAM_H
+#define CATA_SRC_GZIP_OSTREAM_H
+
+#include <memory>
+#include <ostream>
+
+/**
+ * Output stream that gzip-compresses everything written to it and hands the result to another
+ * stream a chunk at a time, so neither the plain nor the compressed data has to be held in
+ * memory as a whole. @ref read_maybe_compressed_file and friends read the result like any
+ * other save file.
+ *
+ * @ref finish must be called after the last write, the destructor only releases zlib state.
+ */
+class gzip_ostream : public std::ostream
+{
+    public:
+        /** @param level zlib compression level, from 1 (fastest) to 9 (smallest) */
+        gzip_ostream( std::ostream &out, int level );
+        ~gzip_ostream() override;
+
+        /** Compresses whatever is still buffered and ends the gzip stream. Throws on failure. */
+        void finish();
+
+    private:
+        class deflate_buffer;
+        std::unique_ptr<deflate_buffer> buffer;
+};
+
+#endif // CATA_SRC_GZIP_OSTREAM_H
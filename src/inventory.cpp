@@ -241,6 +241,7 @@ inventory inventory::operator+ ( const item &rhs )
 void inventory::unsort()
 {
     binned = false;
+    quality_levels.clear();
 }
 
 static bool stack_compare( const std::list<item> &lhs, const std::list<item> &rhs )
@@ -253,7 +254,7 @@ void inventory::clear()
     items.clear();
     max_empty_liq_cont.clear();
     binned = false;
-    qualities_cache.clear();
+    quality_levels.clear();
 }
 
 void inventory::push_back( const std::list<item> &newits )
@@ -301,6 +302,7 @@ char inventory::find_usable_cached_invlet( const itype_id &item_type )
 item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, bool should_stack )
 {
     binned = false;
+    quality_levels.clear();
 
     Character &player_character = get_player_character();
     if( should_stack ) {
@@ -394,6 +396,7 @@ void inventory::restack( Character &p )
     // 3. combine matching stacks
 
     binned = false;
+    quality_levels.clear();
     std::list<item> to_restack;
     int idx = 0;
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter, ++idx ) {
@@ -608,6 +611,7 @@ std::list<item> inventory::reduce_stack( const int position, const int quantity
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            quality_levels.clear();
             if( quantity >= static_cast<int>( iter->size() ) || quantity < 0 ) {
                 ret = *iter;
                 items.erase( iter );
@@ -630,6 +634,7 @@ item inventory::remove_item( const item *it )
     }, 1 );
     if( !tmp.empty() ) {
         binned = false;
+        quality_levels.clear();
         return tmp.front();
     }
     debugmsg( "Tried to remove a item not in inventory." );
@@ -642,6 +647,7 @@ item inventory::remove_item( const int position )
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            quality_levels.clear();
             if( iter->size() > 1 ) {
                 std::list<item>::iterator stack_member = iter->begin();
                 char invlet = stack_member->invlet;
@@ -687,6 +693,7 @@ std::list<item> inventory::remove_randomly_by_volume( const units::volume &volum
         }
         if( chosen_stack->empty() ) {
             binned = false;
+            quality_levels.clear();
             items.erase( chosen_stack );
         }
     }
@@ -783,6 +790,7 @@ std::list<item> inventory::use_amount( const itype_id &it, int quantity,
         }
         if( iter->empty() ) {
             binned = false;
+            quality_levels.clear();
             iter = items.erase( iter );
         } else if( iter != items.end() ) {
             ++iter;
@@ -90,20 +90,6 @@ class invlet_favorites
         std::array<itype_id, 256> ids_by_invlet;
 };
 
-struct quality_query {
-    quality_id qual;
-    int level;
-    int count;
-
-    bool operator==( const quality_query &other ) const {
-        return qual == other.qual && level == other.level && count == other.count;
-    }
-
-    bool operator<( const quality_query &other ) const {
-        return std::tie( qual, level, count ) < std::tie( other.qual, other.level, other.count );
-    }
-};
-
 class inventory : public visitable
 {
     public:
@@ -252,6 +238,7 @@ class inventory : public visitable
 
         // inherited from `visitable`
         bool has_quality( const quality_id &qual, int level = 1, int qty = 1 ) const override;
+        int max_quality( const quality_id &qual ) const override;
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const
         override;
         std::list<item> remove_items_with( const std::function<bool( const item & )> &filter,
@@ -292,7 +279,13 @@ class inventory : public visitable
          */
         mutable itype_bin binned_items;
 
-        mutable std::map<quality_query, bool> qualities_cache;
+        /**
+         * Number of items providing each level of a quality (stack sizes included), filled per
+         * quality on its first query and dropped together with @ref binned_items.
+         * `mutable` because this is a pure cache that doesn't affect the contained items.
+         */
+        mutable std::map<quality_id, std::map<int, int>> quality_levels;
+        const std::map<int, int> &quality_levels_of( const quality_id &qual ) const;
 };
 
 #endif // CATA_SRC_INVENTORY_H
@@ -100,6 +100,8 @@ class item_location::impl
         virtual void on_contents_changed() = 0;
         virtual void serialize( JsonOut &js ) const = 0;
         virtual item *unpack( int ) const = 0;
+        /** Called before the item is handed out for modification */
+        virtual void on_mutable_access() {}
 
         item *target() const {
             ensure_unpacked();
@@ -215,6 +217,11 @@ class item_location::impl::item_on_map : public item_location::impl
             return retrieve_index( cur, idx );
         }
 
+        void on_mutable_access() override {
+            // The item can change through the pointer without the submap noticing
+            get_map().mark_submap_modified( cur.pos() );
+        }
+
         type where() const override {
             return type::map;
         }
@@ -633,6 +640,10 @@ class item_location::impl::item_in_container : public item_location::impl
             }
         }
 
+        void on_mutable_access() override {
+            container.ptr->on_mutable_access();
+        }
+
         Character *carrier() const override {
             return container.carrier();
         }
@@ -784,6 +795,7 @@ item_location::operator bool() const
 
 item &item_location::operator*()
 {
+    ptr->on_mutable_access();
     return *ptr->target();
 }
 
@@ -794,6 +806,7 @@ const item &item_location::operator*() const
 
 item *item_location::operator->()
 {
+    ptr->on_mutable_access();
     return ptr->target();
 }
 
@@ -1086,6 +1099,7 @@ void item_location::make_active()
 
 item *item_location::get_item()
 {
+    ptr->on_mutable_access();
     return ptr->target();
 }
 
@@ -2,7 +2,9 @@
 
 #include <clocale>
 #include <algorithm>
+#include <array>
 #include <bitset>
+#include <charconv>
 #include <cmath> // IWYU pragma: keep
 #include <cstdint>
 #include <cstdio>
@@ -15,6 +17,7 @@
 #include <set>
 #include <sstream> // IWYU pragma: keep
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -2226,7 +2229,8 @@ std::string TextJsonIn::substr( size_t pos, size_t len )
 JsonOut::JsonOut( std::ostream &s, bool pretty, int depth ) :
     stream( &s ), pretty_print( pretty ), indent_level( depth )
 {
-    // ensure consistent and locale-independent formatting of numerals
+    // ensure consistent and locale-independent formatting of anything written to the stream
+    // directly, JsonOut itself formats into its buffer.
     stream->imbue( std::locale::classic() );
     stream->setf( std::ios_base::showpoint );
     stream->setf( std::ios_base::dec, std::ostream::basefield );
@@ -2234,23 +2238,79 @@ JsonOut::JsonOut( std::ostream &s, bool pretty, int depth ) :
 
     // automatically stringify bool to "true" or "false"
     stream->setf( std::ios_base::boolalpha );
+
+    buffer.reserve( flush_size );
+}
+
+JsonOut::~JsonOut()
+{
+    flush();
+}
+
+void JsonOut::flush()
+{
+    if( !buffer.empty() ) {
+        stream->write( buffer.data(), buffer.size() );
+        buffer.clear();
+    }
 }
 
 int JsonOut::tell()
 {
+    flush();
     return stream->tellp();
 }
 
 void JsonOut::seek( int pos )
 {
+    flush();
     stream->clear();
     stream->seekp( pos );
     need_separator = false;
 }
 
+void JsonOut::write_number( const long long val )
+{
+    std::array<char, std::numeric_limits<long long>::digits10 + 3> buf;
+    const std::to_chars_result r = std::to_chars( buf.data(), buf.data() + buf.size(), val );
+    buffer.append( buf.data(), r.ptr );
+}
+
+void JsonOut::write_number( const unsigned long long val )
+{
+    std::array<char, std::numeric_limits<unsigned long long>::digits10 + 3> buf;
+    const std::to_chars_result r = std::to_chars( buf.data(), buf.data() + buf.size(), val );
+    buffer.append( buf.data(), r.ptr );
+}
+
+void JsonOut::write_number( const double val )
+{
+#if defined(__cpp_lib_to_chars)
+    // Same as std::fixed with the default precision, which is what the stream used to do.
+    // Sign, all the digits of the largest double, the point and six decimals.
+    constexpr size_t max_length = std::numeric_limits<double>::max_exponent10 + 16;
+    std::array<char, max_length> buf;
+    const std::to_chars_result r = std::to_chars( buf.data(), buf.data() + buf.size(), val,
+                                   std::chars_format::fixed, 6 );
+    buffer.append( buf.data(), r.ptr );
+#else
+    write_number( static_cast<long double>( val ) );
+#endif
+}
+
+void JsonOut::write_number( const long double val )
+{
+    std::ostringstream os;
+    os.imbue( std::locale::classic() );
+    os.setf( std::ios_base::showpoint );
+    os.setf( std::ios_base::fixed, std::ostream::floatfield );
+    os << val;
+    buffer.append( os.str() );
+}
+
 void JsonOut::write_indent()
 {
-    std::fill_n( std::ostream_iterator<char>( *stream ), indent_level * 2, ' ' );
+    buffer.append( static_cast<size_t>( indent_level ) * 2, ' ' );
 }
 
 void JsonOut::write_separator()
@@ -2258,15 +2318,15 @@ void JsonOut::write_separator()
     if( !need_separator ) {
         return;
     }
-    stream->put( ',' );
+    buffer.push_back( ',' );
     if( pretty_print ) {
         // Wrap after separator between objects and between members of top-level objects.
         if( indent_level < 2 || need_wrap.back() ) {
-            stream->put( '\n' );
+            buffer.push_back( '\n' );
             write_indent();
         } else {
             // Otherwise pad after commas.
-            stream->put( ' ' );
+            buffer.push_back( ' ' );
         }
     }
     need_separator = false;
@@ -2275,11 +2335,12 @@ void JsonOut::write_separator()
 void JsonOut::write_member_separator()
 {
     if( pretty_print ) {
-        stream->write( ": ", 2 );
+        buffer.append( ": " );
     } else {
-        stream->put( ':' );
+        buffer.push_back( ':' );
     }
     need_separator = false;
+    maybe_flush();
 }
 
 void JsonOut::start_pretty()
@@ -2288,11 +2349,11 @@ void JsonOut::start_pretty()
         indent_level += 1;
         // Wrap after top level object and array opening.
         if( indent_level < 2 || need_wrap.back() ) {
-            stream->put( '\n' );
+            buffer.push_back( '\n' );
             write_indent();
         } else {
             // Otherwise pad after opening.
-            stream->put( ' ' );
+            buffer.push_back( ' ' );
         }
     }
 }
@@ -2304,11 +2365,11 @@ void JsonOut::end_pretty()
         // Wrap after ending top level array and object.
         // Also wrap in the special case of exiting an array containing an object.
         if( indent_level < 1 || need_wrap.back() ) {
-            stream->put( '\n' );
+            buffer.push_back( '\n' );
             write_indent();
         } else {
             // Otherwise pad after ending.
-            stream->put( ' ' );
+            buffer.push_back( ' ' );
         }
     }
 }
@@ -2318,7 +2379,7 @@ void JsonOut::start_object( bool wrap )
     if( need_separator ) {
         write_separator();
     }
-    stream->put( '{' );
+    buffer.push_back( '{' );
     need_wrap.push_back( wrap );
     start_pretty();
     need_separator = false;
@@ -2328,8 +2389,9 @@ void JsonOut::end_object()
 {
     end_pretty();
     need_wrap.pop_back();
-    stream->put( '}' );
+    buffer.push_back( '}' );
     need_separator = true;
+    maybe_flush();
 }
 
 void JsonOut::start_array( bool wrap )
@@ -2337,7 +2399,7 @@ void JsonOut::start_array( bool wrap )
     if( need_separator ) {
         write_separator();
     }
-    stream->put( '[' );
+    buffer.push_back( '[' );
     need_wrap.push_back( wrap );
     start_pretty();
     need_separator = false;
@@ -2347,8 +2409,9 @@ void JsonOut::end_array()
 {
     end_pretty();
     need_wrap.pop_back();
-    stream->put( ']' );
+    buffer.push_back( ']' );
     need_separator = true;
+    maybe_flush();
 }
 
 void JsonOut::write_null()
@@ -2356,51 +2419,60 @@ void JsonOut::write_null()
     if( need_separator ) {
         write_separator();
     }
-    stream->write( "null", 4 );
+    buffer.append( "null" );
     need_separator = true;
+    maybe_flush();
 }
 
+namespace
+{
+/**
+ * Escape sequence of every byte that needs one inside a JSON string, empty for the bytes that
+ * are written as they are.
+ */
+struct json_escapes {
+    std::array<std::string, 256> of;
+
+    json_escapes() {
+        of['"'] = "\\\"";
+        of['\\'] = "\\\\";
+        of['\b'] = "\\b";
+        of['\f'] = "\\f";
+        of['\n'] = "\\n";
+        of['\r'] = "\\r";
+        of['\t'] = "\\t";
+        for( unsigned char ch = 0; ch < 0x20; ++ch ) {
+            if( of[ch].empty() ) {
+                // "\uxxxx" unicode escape
+                static constexpr std::string_view hex = "0123456789ABCDEF";
+                of[ch] = std::string( "\\u00" ) + hex[ch >> 4] + hex[ch & 0x0F];
+            }
+        }
+    }
+};
+} // namespace
+
 void JsonOut::write( const std::string_view val )
 {
+    static const json_escapes escapes;
     if( need_separator ) {
         write_separator();
     }
-    stream->put( '"' );
-    for( const char &i : val ) {
-        unsigned char ch = i;
-        if( ch == '"' ) {
-            stream->write( "\\\"", 2 );
-        } else if( ch == '\\' ) {
-            stream->write( "\\\\", 2 );
-        } else if( ch == '/' ) {
-            // don't technically need to escape this
-            stream->put( '/' );
-        } else if( ch == '\b' ) {
-            stream->write( "\\b", 2 );
-        } else if( ch == '\f' ) {
-            stream->write( "\\f", 2 );
-        } else if( ch == '\n' ) {
-            stream->write( "\\n", 2 );
-        } else if( ch == '\r' ) {
-            stream->write( "\\r", 2 );
-        } else if( ch == '\t' ) {
-            stream->write( "\\t", 2 );
-        } else if( ch < 0x20 ) {
-            // convert to "\uxxxx" unicode escape
-            stream->write( "\\u00", 4 );
-            stream->put( ( ch < 0x10 ) ? '0' : '1' );
-            char remainder = ch & 0x0F;
-            if( remainder < 0x0A ) {
-                stream->put( '0' + remainder );
-            } else {
-                stream->put( 'A' + ( remainder - 0x0A ) );
-            }
-        } else {
-            stream->put( ch );
+    buffer.push_back( '"' );
+    // Copy runs of characters that need no escaping in one go.
+    size_t run_start = 0;
+    for( size_t i = 0; i < val.size(); ++i ) {
+        const std::string &escape = escapes.of[static_cast<unsigned char>( val[i] )];
+        if( !escape.empty() ) {
+            buffer.append( val.data() + run_start, i - run_start );
+            buffer.append( escape );
+            run_start = i + 1;
         }
     }
-    stream->put( '"' );
+    buffer.append( val.data() + run_start, val.size() - run_start );
+    buffer.push_back( '"' );
     need_separator = true;
+    maybe_flush();
 }
 
 template<size_t N>
@@ -2409,14 +2481,11 @@ void JsonOut::write( const std::bitset<N> &b )
     if( need_separator ) {
         write_separator();
     }
-    std::string converted = b.to_string();
-    stream->put( '"' );
-    for( char &i : converted ) {
-        unsigned char ch = i;
-        stream->put( ch );
-    }
-    stream->put( '"' );
+    buffer.push_back( '"' );
+    buffer.append( b.to_string() );
+    buffer.push_back( '"' );
     need_separator = true;
+    maybe_flush();
 }
 
 void JsonOut::member( const std::string_view name )
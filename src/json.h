@@ -729,6 +729,11 @@ class TextJsonIn
  * and the constructor also has an option for crude pretty-printing,
  * which inserts newlines and whitespace liberally, if turned on.
  *
+ * Output is collected in an internal buffer and handed to the stream in large blocks, whenever
+ * a top level value is complete, and when the JsonOut is destroyed. Code that needs to write
+ * to the stream directly in the middle of a value must go through get_stream(), which flushes
+ * the buffer first.
+ *
  * Basic containers such as maps, sets and vectors,
  * can be serialized automatically by write() and member().
  */
@@ -736,13 +741,47 @@ class JsonOut
 {
     private:
         std::ostream *stream;
+        /** Output not yet handed to @ref stream */
+        std::string buffer;
         bool pretty_print;
         std::vector<bool> need_wrap;
         int indent_level = 0;
         bool need_separator = false;
 
+        /** Size at which the buffer is flushed even in the middle of a value */
+        static constexpr size_t flush_size = 64 * 1024;
+
+        void flush();
+        /** Flushes once a top level value is complete or the buffer is full */
+        void maybe_flush() {
+            if( need_wrap.empty() || buffer.size() >= flush_size ) {
+                flush();
+            }
+        }
+        void write_number( long long val );
+        void write_number( unsigned long long val );
+        void write_number( double val );
+        void write_number( long double val );
+
+        template <typename T>
+        void write_fundamental( T val ) {
+            if constexpr( std::is_same_v<T, bool> ) {
+                buffer.append( val ? "true" : "false" );
+            } else if constexpr( std::is_integral_v<T> && std::is_signed_v<T> ) {
+                write_number( static_cast<long long>( val ) );
+            } else if constexpr( std::is_integral_v<T> ) {
+                write_number( static_cast<unsigned long long>( val ) );
+            } else if constexpr( std::is_same_v<T, long double> ) {
+                write_number( val );
+            } else {
+                // float is written as double, which is what std::ostream does as well.
+                write_number( static_cast<double>( val ) );
+            }
+        }
+
     public:
         explicit JsonOut( std::ostream &stream, bool pretty_print = false, int depth = 0 );
+        ~JsonOut();
         JsonOut( const JsonOut & ) = delete;
         JsonOut &operator=( const JsonOut & ) = delete;
 
@@ -756,7 +795,9 @@ class JsonOut
         void set_need_separator() {
             need_separator = true;
         }
+        /** The underlying stream, with everything written so far flushed to it */
         std::ostream *get_stream() {
+            flush();
             return stream;
         }
         int tell();
@@ -777,8 +818,9 @@ class JsonOut
             if( need_separator ) {
                 write_separator();
             }
-            *stream << val;
+            write_fundamental( val );
             need_separator = true;
+            maybe_flush();
         }
 
         /// Overload that calls a global function `serialize(const T&,JsonOut&)`, if available.
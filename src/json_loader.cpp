@@ -1,6 +1,7 @@
 #include "json_loader.h"
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 
 #include <ghc/fs_std_fwd.hpp>
@@ -44,25 +45,31 @@ flexbuffer_cache &user_cache()
 
 std::unordered_map<std::string, std::unique_ptr<flexbuffer_cache>> save_caches;
 
-// There's no measurable need to persist flatbuffers for save data, so just create a per-world 'cache' which parses
-// but doesn't disk-cache the parsed flatbuffer.
+// The first element of the path of a save file is the name of its world.
+fs::path world_directory( const cata_path &lexically_normal_path )
+{
+    return fs::u8path( PATH_INFO::savedir() ) / *lexically_normal_path.get_relative_path().begin();
+}
+
+// Reloading a world, or coming back to an area, reads the same submaps, overmaps and map memory
+// again, so each world gets a cache that keeps their flexbuffers on disk too, in "<world>/cache".
+// Saving keeps it in step, see json_loader::update_save_cache.
+fs::path save_cache_directory( const fs::path &world_directory )
+{
+    return world_directory / fs::u8path( "cache" );
+}
+
 flexbuffer_cache &cache_for_save( const cata_path &path )
 {
     // Assume lexically normal path
-    auto path_it = path.get_relative_path().begin();
-    // First path element is the world name
-    fs::path worldname_path = *path_it;
-    std::string worldname_str = worldname_path.u8string();
-    ++path_it;
-    // Next element is either a file, a character folder, or the maps folder
-    std::string folder_or_file = path_it->u8string();
-    ++path_it;
+    const fs::path world_path = world_directory( path );
+    std::string worldname_str = world_path.filename().u8string();
 
     auto it = save_caches.find( worldname_str );
     if( it == save_caches.end() ) {
         it = save_caches.emplace( worldname_str,
-                                  std::make_unique<flexbuffer_cache>( fs::path(),
-                                          fs::u8path( PATH_INFO::savedir() ) / worldname_path ) ).first;
+                                  std::make_unique<flexbuffer_cache>( save_cache_directory( world_path ),
+                                          world_path ) ).first;
     }
 
     return *it->second;
@@ -172,3 +179,35 @@ std::optional<JsonValue> json_loader::from_string_opt( std::string const &data )
     }
     return ret;
 }
+
+void json_loader::invalidate_save_cache( const cata_path &save_file ) noexcept
+{
+    cata_path lexically_normal_path = save_file.lexically_normal();
+    if( lexically_normal_path.get_logical_root() != cata_path::root_path::save ) {
+        return;
+    }
+    const fs::path world_path = world_directory( lexically_normal_path );
+    flexbuffer_cache::remove_on_disk( save_cache_directory( world_path ), world_path,
+                                      lexically_normal_path.get_unrelative_path() );
+}
+
+void json_loader::update_save_cache( const cata_path &save_file,
+                                     const std::string &contents ) noexcept
+{
+    cata_path lexically_normal_path = save_file.lexically_normal();
+    if( lexically_normal_path.get_logical_root() != cata_path::root_path::save ) {
+        return;
+    }
+    // Loading skips the version header some save files start with, so must the flexbuffer.
+    size_t offset = 0;
+    if( !contents.empty() && contents.front() == '#' ) {
+        offset = contents.find( '\n' );
+        if( offset == std::string::npos ) {
+            return;
+        }
+        ++offset;
+    }
+    const fs::path world_path = world_directory( lexically_normal_path );
+    flexbuffer_cache::store_on_disk( save_cache_directory( world_path ), world_path,
+                                     lexically_normal_path.get_unrelative_path(), contents, offset );
+}
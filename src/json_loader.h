@@ -2,6 +2,9 @@
 #ifndef CATA_SRC_JSON_LOADER_H
 #define CATA_SRC_JSON_LOADER_H
 
+#include <optional>
+#include <string>
+
 #include <ghc/fs_std_fwd.hpp>
 
 #include "path_info.h"
@@ -26,6 +29,13 @@ class json_loader
         static JsonValue from_string( std::string const &data ) noexcept( false );
         static std::optional<JsonValue> from_string_opt( std::string const &data ) noexcept( false );
 
+        // Save files are loaded through a cache per world that keeps their flexbuffers on disk.
+        // Whoever rewrites one keeps that in step, from any thread: invalidate_save_cache before
+        // the file is replaced, update_save_cache with what it now contains right after, so the
+        // next load maps the flexbuffer instead of parsing the text. No-ops for other files.
+        static void invalidate_save_cache( const cata_path &save_file ) noexcept;
+        static void update_save_cache( const cata_path &save_file, const std::string &contents ) noexcept;
+
 };
 
 #endif // CATA_SRC_JSON_LOADER_H
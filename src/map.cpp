@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <climits>
 #include <cmath>
 #include <cstdlib>
@@ -610,6 +611,7 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
             ch.zone_vehicles.erase( veh );
             std::unique_ptr<vehicle> result = std::move( current_submap->vehicles[i] );
             current_submap->vehicles.erase( current_submap->vehicles.begin() + i );
+            current_submap->mark_modified();
             if( veh->tracking_on ) {
                 overmap_buffer.remove_vehicle( veh );
             }
@@ -1592,6 +1594,7 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp, const bool adjust_
         auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
         dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
         src_submap->vehicles.erase( src_submap_veh_it );
+        src_submap->mark_modified();
         invalidate_max_populated_zlev( dst.z() );
     }
     if( need_update ) {
@@ -1998,7 +2001,7 @@ uint8_t map::get_known_connections( const tripoint_bub_ms &p,
 #endif
         is_memorized =
         [&]( const tripoint & q ) {
-            return player_character.get_memorized_tile( getglobal( q ) ).symbol != 0;
+            return player_character.get_memorized_tile( getglobal( q ) ).get_symbol() != 0;
         };
 #ifdef TILES
     }
@@ -2082,7 +2085,7 @@ uint8_t map::get_known_connections_f( const tripoint &p,
     } else {
 #endif
         is_memorized = [&]( const tripoint & q ) {
-            return player_character.get_memorized_tile( getglobal( q ) ).symbol != 0;
+            return player_character.get_memorized_tile( getglobal( q ) ).get_symbol() != 0;
         };
 #ifdef TILES
     }
@@ -5016,6 +5019,16 @@ void map::set_temperature_mod( const tripoint &p, units::temperature_delta new_t
 }
 // Items: 3D
 
+void map::mark_submap_modified( const tripoint_bub_ms &p )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    if( submap *const current_submap = unsafe_get_submap_at( p ) ) {
+        current_submap->mark_modified();
+    }
+}
+
 map_stack map::i_at( const tripoint &p )
 {
     if( !inbounds( p ) ) {
@@ -5564,7 +5577,12 @@ static bool process_map_items( map &here, item_stack &items, safe_reference<item
                                item *parent, const tripoint &location, const float insulation,
                                const temperature_flag flag, const float spoil_multiplier )
 {
-    if( item_ref->process( here, nullptr, location, insulation, flag, spoil_multiplier, false ) ) {
+    const itype_id type = item_ref->typeId();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const bool destroy = item_ref->process( here, nullptr, location, insulation, flag,
+                                            spoil_multiplier, false );
+    active_item_stats::record( type, std::chrono::steady_clock::now() - start, destroy );
+    if( destroy ) {
         // Item is to be destroyed so erase it from the map stack
         // unless it was already destroyed by processing.
         if( item_ref ) {
@@ -6292,6 +6310,7 @@ void map::partial_con_remove( const tripoint_bub_ms &p )
         return;
     }
     current_submap->partial_constructions.erase( tripoint_sm_ms( l, p.z() ) );
+    current_submap->mark_modified();
     memory_cache_dec_set_dirty( p.raw(), true );
     avatar &player_character = get_avatar();
     if( player_character.sees( p ) ) {
@@ -6962,8 +6981,8 @@ visibility_type map::get_visibility( const lit_level ll,
 static std::optional<char32_t> get_memory_at( const tripoint &p )
 {
     const memorized_tile &mt = get_avatar().get_memorized_tile( get_map().getglobal( p ) );
-    if( mt.symbol != 0 ) {
-        return mt.symbol;
+    if( mt.get_symbol() != 0 ) {
+        return mt.get_symbol();
     }
     return std::nullopt;
 }
@@ -9045,7 +9064,10 @@ void map::spawn_monsters_submap( const tripoint &gp, bool ignore_sight, bool spa
             }
         }
     }
-    current_submap->spawns.clear();
+    if( !current_submap->spawns.empty() ) {
+        current_submap->spawns.clear();
+        current_submap->mark_modified();
+    }
 }
 
 void map::spawn_monsters( bool ignore_sight, bool spawn_nonlocal )
@@ -9068,7 +9090,10 @@ void map::spawn_monsters( bool ignore_sight, bool spawn_nonlocal )
 void map::clear_spawns()
 {
     for( submap *&smap : grid ) {
-        smap->spawns.clear();
+        if( !smap->spawns.empty() ) {
+            smap->spawns.clear();
+            smap->mark_modified();
+        }
     }
 }
 
@@ -1336,6 +1336,8 @@ class map
         // Returns points for all submaps with inconsistent state relative to
         // the list in map.  Used in tests.
         void check_submap_active_item_consistency();
+        /** Makes the next save write the submap at @p p, for changes made through pointers */
+        void mark_submap_modified( const tripoint_bub_ms &p );
         // Accessor that returns a wrapped reference to an item stack for safe modification.
         // TODO: fix point types (remove the first overload)
         map_stack i_at( const tripoint &p );
@@ -1,3 +1,10 @@
+#include <deque>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 #include "cata_assert.h"
 #include "cached_options.h"
 #include "cata_utility.h"
@@ -85,54 +92,133 @@ bool mm_region::is_empty() const
     return true;
 }
 
+namespace
+{
+
+/** Tile ids memorized this session, the strings never move so they can be used as keys */
+struct memorized_ids {
+    std::deque<std::string> strs;
+    std::unordered_map<std::string_view, uint16_t> index;
+
+    memorized_ids() {
+        strs.emplace_back();
+        index.emplace( strs.back(), 0 );
+    }
+};
+
+memorized_ids &get_memorized_ids()
+{
+    static memorized_ids ids;
+    return ids;
+}
+
+/** Symbols memorized this session, 0 is no symbol */
+struct symbol_palette {
+    std::vector<char32_t> symbols = { 0 };
+    std::unordered_map<char32_t, uint8_t> index = { { 0, 0 } };
+};
+
+symbol_palette &get_symbol_palette()
+{
+    static symbol_palette palette;
+    return palette;
+}
+
+} // namespace
+
+uint16_t memorized_tile::intern_id( const std::string_view id )
+{
+    memorized_ids &ids = get_memorized_ids();
+    const auto it = ids.index.find( id );
+    if( it != ids.index.end() ) {
+        return it->second;
+    }
+    if( ids.strs.size() > std::numeric_limits<uint16_t>::max() ) {
+        debugmsg( "map memory can't store more than %d tile ids, dropping %s", ids.strs.size(), id );
+        return 0;
+    }
+    const uint16_t ret = ids.strs.size();
+    ids.strs.emplace_back( id );
+    ids.index.emplace( ids.strs.back(), ret );
+    return ret;
+}
+
+const std::string &memorized_tile::id_str( const uint16_t id )
+{
+    return get_memorized_ids().strs[id];
+}
+
+char32_t memorized_tile::get_symbol() const
+{
+    return get_symbol_palette().symbols[symbol];
+}
+
+void memorized_tile::set_symbol( const char32_t sym )
+{
+    symbol_palette &palette = get_symbol_palette();
+    const auto it = palette.index.find( sym );
+    if( it != palette.index.end() ) {
+        symbol = it->second;
+        return;
+    }
+    if( palette.symbols.size() > std::numeric_limits<uint8_t>::max() ) {
+        debugmsg( "map memory can't store more than %d symbols", palette.symbols.size() );
+        symbol = 0;
+        return;
+    }
+    symbol = palette.symbols.size();
+    palette.symbols.push_back( sym );
+    palette.index.emplace( sym, symbol );
+}
+
 const std::string &memorized_tile::get_ter_id() const
 {
-    return ter_id.str();
+    return id_str( ter_id );
 }
 
 const std::string &memorized_tile::get_dec_id() const
 {
-    return dec_id;
+    return id_str( dec_id );
 }
 
 void memorized_tile::set_ter_id( const std::string_view id )
 {
-    ter_id = ter_str_id( id );
+    ter_id = intern_id( id );
 }
 
 void memorized_tile::set_dec_id( const std::string_view id )
 {
-    dec_id = id;
+    dec_id = intern_id( id );
 }
 
+static constexpr int max_rotation = 0x0F;
+
 int memorized_tile::get_ter_rotation() const
 {
-    return ter_rotation;
+    return rotations & max_rotation;
 }
 
 void memorized_tile::set_ter_rotation( int rotation )
 {
-    if( rotation < std::numeric_limits<decltype( ter_rotation )>::min() ||
-        rotation > std::numeric_limits<decltype( ter_rotation )>::max() ) {
+    if( rotation < 0 || rotation > max_rotation ) {
         debugmsg( "map memory can't store rotation value %d", rotation );
         rotation = 0;
     }
-    ter_rotation = rotation;
+    rotations = ( rotations & ~max_rotation ) | rotation;
 }
 
 int memorized_tile::get_dec_rotation() const
 {
-    return dec_rotation;
+    return rotations >> 4;
 }
 
 void memorized_tile::set_dec_rotation( int rotation )
 {
-    if( rotation < std::numeric_limits<decltype( dec_rotation )>::min() ||
-        rotation > std::numeric_limits<decltype( dec_rotation )>::max() ) {
+    if( rotation < 0 || rotation > max_rotation ) {
         debugmsg( "map memory can't store rotation value %d", rotation );
         rotation = 0;
     }
-    dec_rotation = rotation;
+    rotations = ( rotations & max_rotation ) | ( rotation << 4 );
 }
 
 int memorized_tile::get_ter_subtile() const
@@ -167,13 +253,23 @@ void memorized_tile::set_dec_subtile( int subtile )
 
 bool memorized_tile::operator==( const memorized_tile &rhs ) const
 {
-    return symbol == rhs.symbol &&
-           ter_rotation == rhs.ter_rotation &&
-           dec_rotation == rhs.dec_rotation &&
+    return ter_id == rhs.ter_id &&
+           dec_id == rhs.dec_id &&
            ter_subtile == rhs.ter_subtile &&
            dec_subtile == rhs.dec_subtile &&
-           ter_id == rhs.ter_id &&
-           dec_id == rhs.dec_id;
+           rotations == rhs.rotations &&
+           symbol == rhs.symbol;
+}
+
+static_assert( sizeof( memorized_tile ) == 8, "memorized_tile is meant to be 8 bytes" );
+
+int mm_id_table::local( const uint16_t id )
+{
+    const auto it = index.emplace( id, static_cast<int>( ids.size() ) );
+    if( it.second ) {
+        ids.push_back( id );
+    }
+    return it.first->second;
 }
 
 map_memory::coord_pair::coord_pair( const tripoint_abs_ms &p )
@@ -233,7 +329,7 @@ void map_memory::set_tile_symbol( const tripoint_abs_ms &pos, char32_t symbol )
         return;
     }
     memorized_tile mt = sm.get_tile( p.loc );
-    mt.symbol = symbol;
+    mt.set_symbol( symbol );
     sm.set_tile( p.loc, mt );
 }
 
@@ -249,7 +345,7 @@ void map_memory::clear_tile_decoration( const tripoint_abs_ms &pos, std::string_
         mt.set_dec_id( "" );
         mt.set_dec_rotation( 0 );
         mt.set_dec_subtile( 0 );
-        mt.symbol = 0;
+        mt.set_symbol( 0 );
     }
     sm.set_tile( p.loc, mt );
 }
@@ -470,7 +566,7 @@ bool map_memory::save( const tripoint_abs_ms &pos )
                 } );
             };
 
-            const bool res = write_to_file( path, writer, descr.c_str() );
+            const bool res = write_save_file( path, writer, descr.c_str() );
             result = result & res;
         }
         const tripoint_abs_sm regp_sm( mmr_to_sm_copy( regp ) );
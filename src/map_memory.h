@@ -2,24 +2,33 @@
 #ifndef CATA_SRC_MAP_MEMORY_H
 #define CATA_SRC_MAP_MEMORY_H
 
+#include <cstdint>
 #include <iosfwd>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "game_constants.h"
 #include "mdarray.h"
 #include "memory_fast.h"
 #include "point.h" // IWYU pragma: keep
 
+class JsonArray;
 class JsonObject;
 class JsonOut;
 class JsonValue;
 
-struct ter_t;
-using ter_str_id = string_id<ter_t>;
-
+/**
+ * A memorized tile, packed into 8 bytes: terrain and decoration ids are interned (see
+ * @ref mm_id_table), the symbol is an index into a palette of the symbols seen this session
+ * and rotations are stored in a nibble each.
+ */
 class memorized_tile
 {
     public:
-        char32_t symbol = 0;
+        char32_t get_symbol() const;
+        void set_symbol( char32_t symbol );
 
         const std::string &get_ter_id() const;
         const std::string &get_dec_id() const;
@@ -42,12 +51,35 @@ class memorized_tile
         }
     private:
         friend struct mm_submap; // serialization needs access to private members
-        ter_str_id ter_id;       // terrain tile id
-        std::string dec_id;      // decoration tile id (furniture, vparts ...)
-        int8_t ter_rotation = 0;
-        int8_t dec_rotation = 0;
+        friend struct mm_id_table;
+
+        /** Interned id of @p id, 0 is the empty id */
+        static uint16_t intern_id( std::string_view id );
+        static const std::string &id_str( uint16_t id );
+
+        uint16_t ter_id = 0;     // interned terrain tile id
+        uint16_t dec_id = 0;     // interned decoration tile id (furniture, vparts ...)
         int8_t ter_subtile = 0;
         int8_t dec_subtile = 0;
+        uint8_t rotations = 0;   // terrain rotation in the low nibble, decoration in the high one
+        uint8_t symbol = 0;      // index into the symbol palette
+};
+
+/**
+ * Tile ids of a saved map memory region. Files refer to ids by their index in the table
+ * written with the region, which is translated to the ids interned this session on load.
+ */
+struct mm_id_table {
+    /** Interned id of each entry of the table */
+    std::vector<uint16_t> ids;
+    /** Index into @ref ids of each interned id, used while saving */
+    std::unordered_map<uint16_t, int> index;
+
+    /** Index of the interned @p id in the table, adding it if needed */
+    int local( uint16_t id );
+
+    void serialize( JsonOut &jsout ) const;
+    void deserialize( const JsonArray &ja );
 };
 
 /** Represent a submap-sized chunk of tile memory. */
@@ -66,8 +98,8 @@ struct mm_submap {
         const memorized_tile &get_tile( const point_sm_ms &p ) const;
         void set_tile( const point_sm_ms &p, const memorized_tile &value );
 
-        void serialize( JsonOut &jsout ) const;
-        void deserialize( int version, const JsonArray &ja );
+        void serialize( JsonOut &jsout, mm_id_table &table ) const;
+        void deserialize( int version, const JsonArray &ja, const mm_id_table &table );
 
     private:
         // NOLINTNEXTLINE(cata-serialize)
@@ -125,6 +125,8 @@ void mapbuffer::save( bool delete_after_save )
 
     int num_saved_submaps = 0;
     int num_total_submaps = submaps.size();
+    int num_quads = 0;
+    int num_written_quads = 0;
 
     map &here = get_map();
 
@@ -166,16 +168,21 @@ void mapbuffer::save( bool delete_after_save )
         bool inside_reality_bubble = here.inbounds( om_addr );
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
-        save_quad( dirname, quad_path, om_addr, submaps_to_delete,
-                   delete_after_save || !inside_reality_bubble );
+        if( save_quad( dirname, quad_path, om_addr, submaps_to_delete,
+                       delete_after_save || !inside_reality_bubble ) ) {
+            num_written_quads++;
+        }
+        num_quads++;
         num_saved_submaps += 4;
     }
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+    dbg( D_INFO ) << "mapbuffer::save: " << num_written_quads << " of " << num_quads
+                  << " submap quads written";
 }
 
-void mapbuffer::save_quad(
+bool mapbuffer::save_quad(
     const cata_path &dirname, const cata_path &filename, const tripoint_abs_omt &om_addr,
     std::list<tripoint_abs_sm> &submaps_to_delete, bool delete_after_save )
 {
@@ -188,6 +195,7 @@ void mapbuffer::save_quad(
 
     bool all_uniform = true;
     bool reverted_to_uniform = false;
+    bool modified = false;
     bool const file_exists = fs::exists( filename.get_unrelative_path() );
     for( point &offsets_offset : offsets ) {
         tripoint_abs_sm submap_addr = project_to<coords::sm>( om_addr );
@@ -195,6 +203,7 @@ void mapbuffer::save_quad(
         submap_addrs.push_back( submap_addr );
         submap *sm = submaps[submap_addr].get();
         if( sm != nullptr ) {
+            modified |= sm->modified_since_save();
             if( !sm->is_uniform() ) {
                 all_uniform = false;
             } else if( sm->reverted ) {
@@ -216,13 +225,23 @@ void mapbuffer::save_quad(
         // deleting the file might fail on some platforms in some edge cases so force serialize this
         // uniform quad
         if( !reverted_to_uniform ) {
-            return;
+            return false;
         }
+    } else if( !modified ) {
+        // Same as what is on disk already
+        if( delete_after_save ) {
+            for( tripoint_abs_sm &submap_addr : submap_addrs ) {
+                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                    submaps_to_delete.push_back( submap_addr );
+                }
+            }
+        }
+        return false;
     }
 
     // Don't create the directory if it would be empty
     assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
+    write_save_file( filename, [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
@@ -258,10 +277,18 @@ void mapbuffer::save_quad(
 
         jsout.end_array();
     } );
+    // Only once the file is written, write_save_file throws on failure
+    for( tripoint_abs_sm &submap_addr : submap_addrs ) {
+        const auto it = submaps.find( submap_addr );
+        if( it != submaps.end() && it->second != nullptr ) {
+            it->second->mark_saved();
+        }
+    }
 
     if( all_uniform && reverted_to_uniform ) {
         fs::remove( filename.get_unrelative_path() );
     }
+    return true;
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -325,6 +352,8 @@ void mapbuffer::deserialize( const JsonArray &ja )
             }
         }
 
+        // Matches the file now, no need to write it back unless it changes
+        sm->mark_saved();
         if( !add_submap( submap_coordinates, sm ) ) {
             debugmsg( "submap %s was already loaded", submap_coordinates.to_string() );
         }
@@ -231,6 +231,9 @@ double func_jmath::eval( dialogue &d ) const
 
 double var::eval( dialogue &d ) const
 {
+    if( std::optional<double> const num = maybe_read_var_number( varinfo, d ); num ) {
+        return *num;
+    }
     std::string const str = read_var_value( varinfo, d );
     if( str.empty() ) {
         return 0;
@@ -266,11 +269,207 @@ double ternary::eval( dialogue &d ) const
     return cond->eval( d ) > 0 ? mhs->eval( d ) : rhs->eval( d );
 }
 
+namespace
+{
+// functions that may give different results for the same arguments or report errors
+bool is_pure( math_func::f_t f )
+{
+    return f != static_cast<math_func::f_t>( math_rng ) &&
+           f != static_cast<math_func::f_t>( rand ) &&
+           f != static_cast<math_func::f_t>( clamp );
+}
+} // namespace
+
+math_program::math_program( thingie const &tree )
+{
+    compile( tree );
+}
+
+void math_program::emit( instr const &i, int stack_effect )
+{
+    code.emplace_back( i );
+    depth += stack_effect;
+    max_depth = std::max( max_depth, depth );
+}
+
+double math_program::pop_constant()
+{
+    double const val = code.back().value;
+    code.pop_back();
+    depth--;
+    return val;
+}
+
+bool math_program::compile_params( std::vector<thingie> const &params )
+{
+    bool constant = true;
+    for( thingie const &p : params ) {
+        constant &= compile( p );
+    }
+    return constant;
+}
+
+bool math_program::compile( thingie const &t )
+{
+    instr i;
+    return std::visit( overloaded{
+        [&]( double v )
+        {
+            i.value = v;
+            emit( i, 1 );
+            return true;
+        },
+        [&]( oper const & v )
+        {
+            bool const l_constant = compile( *v.l );
+            bool const r_constant = compile( *v.r );
+            if( l_constant && r_constant ) {
+                double const r = pop_constant();
+                double const l = pop_constant();
+                i.value = v.op( l, r );
+                emit( i, 1 );
+                return true;
+            }
+            i.code = opcode::oper;
+            i.op = v.op;
+            emit( i, -1 );
+            return false;
+        },
+        [&]( func const & v )
+        {
+            if( compile_params( v.params ) && is_pure( v.f ) ) {
+                std::vector<double> args( v.params.size() );
+                for( auto it = args.rbegin(); it != args.rend(); ++it ) {
+                    *it = pop_constant();
+                }
+                i.value = v.f( args );
+                emit( i, 1 );
+                return true;
+            }
+            i.code = opcode::func;
+            i.f = v.f;
+            i.nparams = v.params.size();
+            emit( i, 1 - static_cast<int>( i.nparams ) );
+            return false;
+        },
+        [&]( func_jmath const & v )
+        {
+            compile_params( v.params );
+            i.code = opcode::jmath;
+            i.arg = jmath_funcs.size();
+            i.nparams = v.params.size();
+            jmath_funcs.emplace_back( v.id );
+            emit( i, 1 - static_cast<int>( i.nparams ) );
+            return false;
+        },
+        [&]( func_diag_eval const & v )
+        {
+            i.code = opcode::diag;
+            i.arg = diag_funcs.size();
+            diag_funcs.emplace_back( v.f );
+            emit( i, 1 );
+            return false;
+        },
+        [&]( var const & v )
+        {
+            i.code = opcode::var;
+            i.arg = vars.size();
+            vars.emplace_back( v );
+            emit( i, 1 );
+            return false;
+        },
+        [&]( ternary const & v )
+        {
+            if( compile( *v.cond ) ) {
+                return compile( pop_constant() > 0 ? *v.mhs : *v.rhs );
+            }
+            i.code = opcode::jump_if_not;
+            size_t const jump_to_rhs = code.size();
+            emit( i, -1 );
+            compile( *v.mhs );
+            i.code = opcode::jump;
+            size_t const jump_to_end = code.size();
+            emit( i, 0 );
+            // only one of the branches ends up on the stack
+            depth--;
+            code[jump_to_rhs].arg = code.size();
+            compile( *v.rhs );
+            code[jump_to_end].arg = code.size();
+            return false;
+        },
+        [&]( auto const &/* v */ )
+        {
+            // strings, kwargs, arrays and assignment functions only report errors
+            i.code = opcode::tree;
+            i.arg = fallback.size();
+            fallback.emplace_back( t );
+            emit( i, 1 );
+            return false;
+        },
+    },
+    t.data );
+}
+
+double math_program::eval( dialogue &d ) const
+{
+    std::array<double, 16> small_stack;
+    std::vector<double> large_stack;
+    double *stack = small_stack.data();
+    if( max_depth > small_stack.size() ) {
+        large_stack.resize( max_depth );
+        stack = large_stack.data();
+    }
+    size_t sp = 0;
+    size_t pc = 0;
+    while( pc < code.size() ) {
+        instr const &i = code[pc++];
+        switch( i.code ) {
+            case opcode::push:
+                stack[sp++] = i.value;
+                break;
+            case opcode::oper:
+                sp--;
+                stack[sp - 1] = i.op( stack[sp - 1], stack[sp] );
+                break;
+            case opcode::func:
+                sp -= i.nparams;
+                stack[sp] = i.f( std::vector<double>( stack + sp, stack + sp + i.nparams ) );
+                sp++;
+                break;
+            case opcode::jmath:
+                sp -= i.nparams;
+                stack[sp] = jmath_funcs[i.arg]->eval(
+                                d, std::vector<double>( stack + sp, stack + sp + i.nparams ) );
+                sp++;
+                break;
+            case opcode::diag:
+                stack[sp++] = diag_funcs[i.arg]( d );
+                break;
+            case opcode::var:
+                stack[sp++] = vars[i.arg].eval( d );
+                break;
+            case opcode::tree:
+                stack[sp++] = fallback[i.arg].eval( d );
+                break;
+            case opcode::jump_if_not:
+                sp--;
+                if( !( stack[sp] > 0 ) ) {
+                    pc = i.arg;
+                }
+                break;
+            case opcode::jump:
+                pc = i.arg;
+                break;
+        }
+    }
+    return sp > 0 ? stack[sp - 1] : 0;
+}
+
 class math_exp::math_exp_impl
 {
     public:
         math_exp_impl() = default;
-        explicit math_exp_impl( thingie &&t ): tree( t ) {}
+        explicit math_exp_impl( thingie &&t ): tree( t ), program( tree ) {}
 
         bool parse( std::string_view str, bool assignment ) {
             if( str.empty() ) {
@@ -288,11 +487,16 @@ class math_exp::math_exp_impl
                 output = {};
                 arity = {};
                 tree = thingie { 0.0 };
+                program = math_program( tree );
                 return false;
             }
+            program = math_program( tree );
             return true;
         }
         double eval( dialogue &d ) const {
+            return program.eval( d );
+        }
+        double eval_tree( dialogue &d ) const {
             return tree.eval( d );
         }
 
@@ -337,6 +541,7 @@ class math_exp::math_exp_impl
         };
         std::stack<arity_t> arity;
         thingie tree{ 0.0 };
+        math_program program;
         std::string_view last_token;
         parse_state state;
 
@@ -860,6 +1065,11 @@ double math_exp::eval( dialogue &d ) const
     return impl->eval( d );
 }
 
+double math_exp::eval_tree( dialogue &d ) const
+{
+    return impl->eval_tree( d );
+}
+
 void math_exp::assign( dialogue &d, double val ) const
 {
     return impl->assign( d, val );
@@ -22,6 +22,8 @@ class math_exp
 
         bool parse( std::string_view str, bool assignment = false );
         double eval( dialogue &d ) const;
+        /** Evaluates the parse tree instead of the compiled program, to verify the latter */
+        double eval_tree( dialogue &d ) const;
         void assign( dialogue &d, double val ) const;
 
     private:
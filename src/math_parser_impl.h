@@ -4,6 +4,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -179,6 +180,55 @@ constexpr double thingie::eval( dialogue &d ) const
     data );
 }
 
+// Flat stack machine code compiled from a parse tree. Constant subexpressions are folded
+// at compile time, anything that can't be compiled is evaluated through the tree instead.
+class math_program
+{
+    public:
+        math_program() = default;
+        explicit math_program( thingie const &tree );
+
+        double eval( dialogue &d ) const;
+
+    private:
+        enum class opcode : uint8_t {
+            push = 0,
+            oper,
+            func,
+            jmath,
+            diag,
+            var,
+            tree,
+            jump_if_not,
+            jump,
+        };
+        struct instr {
+            opcode code = opcode::push;
+            // value for push
+            double value = 0;
+            binary_op::f_t op{};
+            math_func::f_t f{};
+            // index into the tables below, or target of jumps
+            uint32_t arg = 0;
+            // parameter count of func and jmath
+            uint32_t nparams = 0;
+        };
+
+        std::vector<instr> code;
+        std::vector<jmath_func_id> jmath_funcs;
+        std::vector<func_diag_eval::eval_f> diag_funcs;
+        std::vector<var> vars;
+        std::vector<thingie> fallback;
+        size_t max_depth = 0;
+        size_t depth = 0;
+
+        // returns true if t compiled to a single constant push
+        bool compile( thingie const &t );
+        bool compile_params( std::vector<thingie> const &params );
+        void emit( instr const &i, int stack_effect );
+        double pop_constant();
+};
+
 using op_t =
     std::variant<pbin_op, punary_op, pmath_func, jmath_func_id, scoped_diag_eval, scoped_diag_ass, paren>;
 
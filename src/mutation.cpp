@@ -110,7 +110,25 @@ std::string enum_to_string<mutagen_technique>( mutagen_technique data )
 
 bool Character::has_trait( const trait_id &b ) const
 {
-    return my_mutations.count( b ) || enchantment_cache->get_mutations().count( b );
+    const int bit = b.id().to_i();
+    return bit >= 0 && static_cast<size_t>( bit ) < trait_bits.size() && trait_bits[bit];
+}
+
+void Character::rebuild_trait_bits()
+{
+    trait_bits.assign( mutation_branch::get_all().size(), false );
+    const auto set_bit = [this]( const trait_id & mut ) {
+        const int bit = mut.id().to_i();
+        if( bit >= 0 && static_cast<size_t>( bit ) < trait_bits.size() ) {
+            trait_bits[bit] = true;
+        }
+    };
+    for( const std::pair<const trait_id, trait_data> &mut : my_mutations ) {
+        set_bit( mut.first );
+    }
+    for( const trait_id &mut : enchantment_cache->get_mutations() ) {
+        set_bit( mut );
+    }
 }
 
 bool Character::has_trait_variant( const trait_and_var &test ) const
@@ -256,6 +274,7 @@ void Character::set_mutation_unsafe( const trait_id &trait, const mutation_varia
     }
     my_mutations.emplace( trait, trait_data{variant} );
     cached_mutations.push_back( &trait.obj() );
+    rebuild_trait_bits();
     if( !trait.obj().vanity ) {
         mutation_effect( trait, false );
     }
@@ -311,6 +330,7 @@ void Character::unset_mutation( const trait_id &trait_ )
     cached_mutations.erase( std::remove( cached_mutations.begin(), cached_mutations.end(), &mut ),
                             cached_mutations.end() );
     my_mutations.erase( iter );
+    rebuild_trait_bits();
     if( !mut.vanity ) {
         mutation_loss_effect( trait );
     }
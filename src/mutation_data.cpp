@@ -61,6 +61,14 @@ bool string_id<mutation_branch>::is_valid() const
     return trait_factory.is_valid( *this );
 }
 
+/** @relates string_id */
+template<>
+int_id<mutation_branch> string_id<mutation_branch>::id() const
+{
+    // Unknown traits map to -1, which no character can have
+    return trait_factory.convert( *this, int_id<mutation_branch>( -1 ), false );
+}
+
 template<>
 bool string_id<Trait_group>::is_valid() const
 {
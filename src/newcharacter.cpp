@@ -4727,6 +4727,7 @@ void Character::clear_mutations()
     while( !my_mutations.empty() ) {
         const trait_id trait = my_mutations.begin()->first;
         my_mutations.erase( my_mutations.begin() );
+        rebuild_trait_bits();
         mutation_loss_effect( trait );
     }
     cached_mutations.clear();
@@ -2806,6 +2806,11 @@ void options_manager::add_options_world_default()
              to_translation( "If true, spawn zombies at shelters.  Makes the starting game a lot harder." ),
              false
            );
+
+        add( "SAVE_COMPRESSION", page_id, to_translation( "Save compression" ),
+             to_translation( "Compression level for map, overmap, map memory and character save files.  0 saves them uncompressed, 1 is the fastest and 9 the smallest.  Saves load either way, so this can be changed at any time." ),
+             0, 9, 0
+           );
     } );
 
     add_empty_line();
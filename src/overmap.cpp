@@ -2941,12 +2941,39 @@ oter_id overmap::get_default_terrain( int z ) const
     return settings->default_oter[OVERMAP_DEPTH + z].id();
 }
 
+const map_layer::terrain_array &overmap::layer_terrain( int z ) const
+{
+    const map_layer &l = layer[z];
+    if( !l.terrain ) {
+        l.terrain = cata::make_value<map_layer::terrain_array>( get_default_terrain(
+                        z - OVERMAP_DEPTH ) );
+        if( !l.terrain_runs.empty() ) {
+            int pos = 0;
+            for( const std::pair<oter_id, int> &run : l.terrain_runs ) {
+                for( int end = pos + run.second; pos < end; ++pos ) {
+                    ( *l.terrain )[pos % OMAPX][pos / OMAPX] = run.first;
+                }
+            }
+            l.terrain_runs.clear();
+            l.terrain_runs.shrink_to_fit();
+        }
+    }
+    return *l.terrain;
+}
+
+map_layer::terrain_array &overmap::layer_terrain( int z )
+{
+    static_cast<const overmap *>( this )->layer_terrain( z );
+    return *layer[z].terrain;
+}
+
 void overmap::init_layers()
 {
     for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
-        const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
         map_layer &l = layer[k];
-        l.terrain.fill( tid );
+        // Default terrain until something is placed, see layer_terrain.
+        l.terrain.reset();
+        l.terrain_runs.clear();
         l.visible.fill( false );
         l.explored.fill( false );
     }
@@ -2959,7 +2986,7 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         return;
     }
 
-    oter_id &current_oter = layer[p.z() + OVERMAP_DEPTH].terrain[p.xy()];
+    oter_id &current_oter = layer_terrain( p.z() + OVERMAP_DEPTH )[p.xy()];
     const oter_type_str_id &current_type_id = current_oter->get_type_id();
     const oter_type_str_id &incoming_type_id = id->get_type_id();
     const bool current_type_same = current_type_id == incoming_type_id;
@@ -2990,6 +3017,9 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         // We had a predecessor, and it was the same type as the incoming one
         // Don't push another copy.
     }
+    if( current_oter != id ) {
+        terrain_index_valid[p.z() + OVERMAP_DEPTH] = false;
+    }
     current_oter = id;
 }
 
@@ -3005,7 +3035,7 @@ const oter_id &overmap::ter( const tripoint_om_omt &p ) const
 
 const oter_id &overmap::ter_unsafe( const tripoint_om_omt &p ) const
 {
-    return layer[p.z() + OVERMAP_DEPTH].terrain[p.xy()];
+    return layer_terrain( p.z() + OVERMAP_DEPTH )[p.xy()];
 }
 
 std::optional<mapgen_arguments> *overmap::mapgen_args( const tripoint_om_omt &p )
@@ -3111,6 +3141,9 @@ void overmap::insert_npc( const shared_ptr_fast<npc> &who )
 
 shared_ptr_fast<npc> overmap::erase_npc( const character_id &id )
 {
+    wake_npcs( [&id]( const dormant_npc & guy ) {
+        return guy.id == id;
+    } );
     const auto iter = std::find_if( npcs.begin(),
     npcs.end(), [id]( const shared_ptr_fast<npc> &n ) {
         return n->getID() == id;
@@ -3124,12 +3157,34 @@ shared_ptr_fast<npc> overmap::erase_npc( const character_id &id )
     return ptr;
 }
 
+void overmap::wake_npcs( const std::function<bool( const dormant_npc & )> &predicate ) const
+{
+    const auto first_awake = std::stable_partition( dormant_npcs.begin(), dormant_npcs.end(),
+    [&predicate]( const dormant_npc & guy ) {
+        return !predicate( guy );
+    } );
+    for( auto it = first_awake; it != dormant_npcs.end(); ++it ) {
+        if( shared_ptr_fast<npc> guy = it->wake() ) {
+            npcs.push_back( std::move( guy ) );
+        }
+    }
+    dormant_npcs.erase( first_awake, dormant_npcs.end() );
+}
+
+const std::vector<shared_ptr_fast<npc>> &overmap::get_npcs() const
+{
+    wake_npcs( []( const dormant_npc & ) {
+        return true;
+    } );
+    return npcs;
+}
+
 std::vector<shared_ptr_fast<npc>> overmap::get_npcs( const
                                std::function<bool( const npc & )>
                                &predicate ) const
 {
     std::vector<shared_ptr_fast<npc>> result;
-    for( const auto &g : npcs ) {
+    for( const auto &g : get_npcs() ) {
         if( predicate( *g ) ) {
             result.push_back( g );
         }
@@ -3418,12 +3473,7 @@ void overmap::generate( const overmap *north, const overmap *east,
         } ) ) {
             dbg( D_INFO ) << "failed" << fpath;
             int z = 0;
-            for( int j = 0; j < OMAPY; j++ ) {
-                // NOLINTNEXTLINE(modernize-loop-convert)
-                for( int i = 0; i < OMAPX; i++ ) {
-                    layer[z + OVERMAP_DEPTH].terrain[i][j] = omt_outside_defined_omap;
-                }
-            }
+            layer_terrain( z + OVERMAP_DEPTH ).fill( omt_outside_defined_omap );
         }
     }
     calculate_urbanity();
@@ -3900,6 +3950,36 @@ std::vector<point_abs_omt> overmap::find_terrain( const std::string_view term, i
     return found;
 }
 
+std::vector<tripoint_om_omt> overmap::find_terrain_matching( int z,
+        const std::function<bool( const oter_id & )> &matches ) const
+{
+    static_assert( OMAPX * OMAPY <= UINT16_MAX + 1, "terrain index positions must fit in 16 bits" );
+    std::vector<tripoint_om_omt> found;
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return found;
+    }
+    std::unordered_map<oter_id, std::vector<uint16_t>> &index = terrain_index[z + OVERMAP_DEPTH];
+    if( !terrain_index_valid[z + OVERMAP_DEPTH] ) {
+        index.clear();
+        const map_layer::terrain_array &terrain = layer_terrain( z + OVERMAP_DEPTH );
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                index[terrain[x][y]].push_back( static_cast<uint16_t>( x * OMAPY + y ) );
+            }
+        }
+        terrain_index_valid[z + OVERMAP_DEPTH] = true;
+    }
+    for( const std::pair<const oter_id, std::vector<uint16_t>> &entry : index ) {
+        if( !matches( entry.first ) ) {
+            continue;
+        }
+        for( const uint16_t packed : entry.second ) {
+            found.emplace_back( packed / OMAPY, packed % OMAPY, z );
+        }
+    }
+    return found;
+}
+
 const city &overmap::get_nearest_city( const tripoint_om_omt &p ) const
 {
     int distance = 999;
@@ -4109,7 +4189,9 @@ void mongroup::wander( const overmap &om )
 void overmap::move_hordes()
 {
     // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
+    // The nodes are moved out of the map and back in, so the groups (and their monsters)
+    // are relocated without being copied.
+    std::vector<decltype( zg )::node_type> moved_groups;
     //MOVE ZOMBIE GROUPS
     for( auto it = zg.begin(); it != zg.end(); ) {
         mongroup &mg = it->second;
@@ -4165,17 +4247,35 @@ void overmap::move_hordes()
                 mg.abs_pos.y()++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.emplace( mg.rel_pos(), mg );
-            zg.erase( it++ );
+            // Take the group out of its old location, it is put back at the new location below
+            decltype( zg )::node_type node = zg.extract( it++ );
+            node.key() = mg.rel_pos();
+            moved_groups.emplace_back( std::move( node ) );
         } else {
             ++it;
         }
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    for( decltype( zg )::node_type &node : moved_groups ) {
+        zg.insert( std::move( node ) );
+    }
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
+        // Whether monsters on the given terrain may join hordes, see below.
+        // Looked up once per terrain instead of matching its id for every monster.
+        std::unordered_map<oter_id, bool> wander_terrain;
+        const auto is_wander_terrain = [&wander_terrain]( const oter_id & ot ) {
+            const auto found = wander_terrain.find( ot );
+            if( found != wander_terrain.end() ) {
+                return found->second;
+            }
+            const bool result = is_ot_match( "field", ot, ot_match_type::contains ) ||
+                                is_ot_match( "road", ot, ot_match_type::contains ) ||
+                                is_ot_match( "forest", ot, ot_match_type::prefix ) ||
+                                is_ot_match( "swamp", ot, ot_match_type::prefix );
+            wander_terrain.emplace( ot, result );
+            return result;
+        };
 
         // Re-absorb zombies into hordes.
         // Scan over monsters outside the player's view and place them back into hordes.
@@ -4204,16 +4304,9 @@ void overmap::move_hordes()
             }
 
             // Only monsters in the open (fields, forests, roads) are eligible to wander
-            const oter_id &om_here = ter( project_to<coords::omt>( p ) );
-            if( !is_ot_match( "field", om_here, ot_match_type::contains ) ) {
-                if( !is_ot_match( "road", om_here, ot_match_type::contains ) ) {
-                    if( !is_ot_match( "forest", om_here, ot_match_type::prefix ) ) {
-                        if( !is_ot_match( "swamp", om_here, ot_match_type::prefix ) ) {
-                            monster_map_it++;
-                            continue;
-                        }
-                    }
-                }
+            if( !is_wander_terrain( ter( project_to<coords::omt>( p ) ) ) ) {
+                monster_map_it++;
+                continue;
             }
 
             // Scan for compatible hordes in this area, selecting the largest.
@@ -4260,7 +4353,7 @@ void overmap::move_hordes()
 void overmap::move_nemesis()
 {
     // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
+    std::optional<decltype( zg )::node_type> moved_group;
     //cycle through zombie groups, skip non-nemesis hordes
     for( std::multimap<tripoint_om_sm, mongroup>::iterator it = zg.begin(); it != zg.end(); ) {
         mongroup &mg = it->second;
@@ -4308,9 +4401,9 @@ void overmap::move_nemesis()
             //update the horde's om_sm coords from the abs_sm so it can spawn in correctly
             if( project_to<coords::om>( mg.nemesis_target ) == omp ) {
 
-                // Erase the group at its old location, add the group with the new location
-                tmpzg.emplace( mg.rel_pos(), mg );
-                zg.erase( it++ );
+                // Take the group out of its old location, it is put back at the new location below
+                moved_group = zg.extract( it++ );
+                moved_group->key() = mg.rel_pos();
 
                 //there is only one nemesis horde, so we can stop looping after we move it
                 break;
@@ -4326,7 +4419,9 @@ void overmap::move_nemesis()
         }
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    if( moved_group ) {
+        zg.insert( std::move( *moved_group ) );
+    }
 
 }
 
@@ -7301,11 +7396,11 @@ void overmap::open( overmap_special_batch &enabled_specials )
 // Note: this may throw io errors from std::ofstream
 void overmap::save() const
 {
-    write_to_file( overmapbuffer::player_filename( loc ), [&]( std::ostream & stream ) {
+    write_save_file( overmapbuffer::player_filename( loc ), [&]( std::ostream & stream ) {
         serialize_view( stream );
     } );
 
-    write_to_file( overmapbuffer::terrain_filename( loc ), [&]( std::ostream & stream ) {
+    write_save_file( overmapbuffer::terrain_filename( loc ), [&]( std::ostream & stream ) {
         serialize( stream );
     } );
 }
@@ -7389,6 +7484,9 @@ void overmap::add_mon_group( const mongroup &group, int radius )
 
 shared_ptr_fast<npc> overmap::find_npc( const character_id &id ) const
 {
+    wake_npcs( [&id]( const dormant_npc & guy ) {
+        return guy.id == id;
+    } );
     for( const auto &guy : npcs ) {
         if( guy->getID() == id ) {
             return guy;
@@ -7399,6 +7497,9 @@ shared_ptr_fast<npc> overmap::find_npc( const character_id &id ) const
 
 shared_ptr_fast<npc> overmap::find_npc_by_unique_id( const std::string &id ) const
 {
+    wake_npcs( [&id]( const dormant_npc & guy ) {
+        return guy.unique_id == id;
+    } );
     for( const auto &guy : npcs ) {
         if( guy->get_unique_id() == id ) {
             return guy;
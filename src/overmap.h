@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
@@ -18,8 +19,9 @@
 #include <vector>
 
 #include "basecamp.h"
+#include "character_id.h"
 #include "city.h"
-#include "coords_fwd.h"
+#include "coordinates.h"
 #include "cube_direction.h"
 #include "enums.h"
 #include "game_constants.h"
@@ -31,15 +33,16 @@
 #include "point.h"
 #include "rng.h"
 #include "type_id.h"
+#include "value_ptr.h"
 
 class JsonArray;
 class JsonObject;
 class JsonOut;
 class cata_path;
-class character_id;
 class npc;
 class overmap_connection;
 struct regional_settings;
+enum npc_mission : int;
 
 namespace pf
 {
@@ -89,7 +92,17 @@ struct radio_tower {
 };
 
 struct map_layer {
-    cata::mdarray<oter_id, point_om_omt> terrain;
+    using terrain_array = cata::mdarray<oter_id, point_om_omt>;
+    /**
+     * Terrain of the layer, only allocated on first access through overmap::layer_terrain.
+     * Until then the layer is either all default terrain or described by terrain_runs.
+     */
+    mutable cata::value_ptr<terrain_array> terrain;
+    /**
+     * Terrain as it was loaded, in the run-length encoding of the save file (runs of
+     * (terrain, count), filled row by row). Emptied once the layer has been expanded.
+     */
+    mutable std::vector<std::pair<oter_id, int>> terrain_runs;
     cata::mdarray<bool, point_om_omt> visible;
     cata::mdarray<bool, point_om_omt> explored;
     std::vector<om_note> notes;
@@ -181,6 +194,25 @@ struct std::hash<pos_dir<Tripoint>> {
     }
 };
 
+/**
+ * An npc of an overmap that nothing has needed since the overmap was loaded. Instead of the
+ * npc itself (inventory, worn items, missions and all) it keeps the JSON it was saved as and
+ * the few things npcs are looked up by. The npc is only deserialized once something asks for
+ * it, see @ref overmap::wake_npcs, and saving writes the JSON back as it is.
+ */
+struct dormant_npc {
+    character_id id;
+    std::string unique_id;
+    tripoint_abs_ms pos;
+    npc_mission mission{};
+    /** Whether the npc is away on a companion mission, see @ref npc::has_companion_mission */
+    bool companion_mission = false;
+    std::string json;
+
+    /** Deserializes the npc, nullptr (and a debugmsg) if that fails. */
+    shared_ptr_fast<npc> wake() const;
+};
+
 class overmap
 {
     public:
@@ -205,6 +237,20 @@ class overmap
         }
 
         void save() const;
+        /** Save tracking, unchanged overmaps are not written again by @ref overmapbuffer::save */
+        void mark_modified() {
+            modified = true;
+        }
+        void mark_saved() {
+            modified = false;
+        }
+        /**
+         * NPCs and camps change without going through the overmapbuffer, so those always count.
+         * Dormant NPCs are saved exactly as they were loaded and don't.
+         */
+        bool modified_since_save() const {
+            return modified || !npcs.empty() || !camps.empty();
+        }
 
         /**
          * @return The (local) overmap terrain coordinates of a randomly
@@ -225,6 +271,14 @@ class overmap
          * coordinates), or empty vector if no matching terrain is found.
          */
         std::vector<point_abs_omt> find_terrain( std::string_view term, int zlevel ) const;
+        /**
+         * Return the (local) coordinates of every terrain on z-level @p z for which
+         * @p matches returns true. @p matches is called once per distinct terrain on that
+         * level, the positions come from an index that is built on first use and rebuilt
+         * after @ref ter_set changed the level.
+         */
+        std::vector<tripoint_om_omt> find_terrain_matching( int z,
+                const std::function<bool( const oter_id & )> &matches ) const;
 
         void ter_set( const tripoint_om_omt &p, const oter_id &id );
         // ter has bounds checking, and returns ot_null when out of bounds.
@@ -331,9 +385,8 @@ class overmap
         shared_ptr_fast<npc> erase_npc( const character_id &id );
         shared_ptr_fast<npc> find_npc( const character_id &id ) const;
         shared_ptr_fast<npc> find_npc_by_unique_id( const std::string &id ) const;
-        const std::vector<shared_ptr_fast<npc>> &get_npcs() const {
-            return npcs;
-        }
+        /** All npcs of this overmap, which wakes the dormant ones. */
+        const std::vector<shared_ptr_fast<npc>> &get_npcs() const;
         std::vector<shared_ptr_fast<npc>> get_npcs( const std::function<bool( const npc & )>
                                        &predicate )
                                        const;
@@ -341,14 +394,30 @@ class overmap
     private:
         friend class overmapbuffer;
 
-        std::vector<shared_ptr_fast<npc>> npcs;
+        /**
+         * Deserializes the dormant npcs for which @p predicate is true and moves them over to
+         * @ref npcs. Whoever looks for npcs by position, id and the like should wake just the
+         * matching ones with this first, instead of all of them through @ref get_npcs.
+         */
+        void wake_npcs( const std::function<bool( const dormant_npc & )> &predicate ) const;
+
+        // Both change when dormant npcs are woken, which doesn't change the overmap itself.
+        mutable std::vector<shared_ptr_fast<npc>> npcs;
+        mutable std::vector<dormant_npc> dormant_npcs;
 
         // A fake boolean that's returned for out-of-bounds calls to
         // overmap::seen and overmap::explored
         bool nullbool = false; // NOLINT(cata-serialize)
+        // A new overmap has never been saved
+        bool modified = true; // NOLINT(cata-serialize)
         point_abs_om loc; // NOLINT(cata-serialize)
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
+        // Positions (x * OMAPY + y) of each terrain for every z-level, see find_terrain_matching.
+        // A level is only valid as long as ter_set has not changed it since it was built.
+        mutable std::array<std::unordered_map<oter_id, std::vector<uint16_t>>, OVERMAP_LAYERS>
+        terrain_index; // NOLINT(cata-serialize)
+        mutable std::array<bool, OVERMAP_LAYERS> terrain_index_valid = {}; // NOLINT(cata-serialize)
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
 
         // Records the locations where a given overmap special was placed, which
@@ -376,6 +445,12 @@ class overmap
         const regional_settings *settings;
 
         oter_id get_default_terrain( int z ) const;
+        /**
+         * Terrain of layer @p z (index into @ref layer, not a z-level), expanding it from the
+         * default terrain or from the runs it was loaded as if that hasn't happened yet.
+         */
+        map_layer::terrain_array &layer_terrain( int z );
+        const map_layer::terrain_array &layer_terrain( int z ) const;
 
         // Initialize
         void init_layers();
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstdlib>
 #include <iterator>
 #include <list>
 #include <map>
@@ -81,12 +82,15 @@ cata_path overmapbuffer::player_filename( const point_abs_om &p )
 
 overmap &overmapbuffer::get( const point_abs_om &p )
 {
+    // Whoever asks for an overmap may change it, so it has to be saved again
     if( last_requested_overmap != nullptr && last_requested_overmap->pos() == p ) {
+        last_requested_overmap->mark_modified();
         return *last_requested_overmap;
     }
 
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
+        it->second->mark_modified();
         return *( last_requested_overmap = it->second.get() );
     }
 
@@ -116,6 +120,57 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
     new_om.populate( specials );
 }
 
+bool overmapbuffer::prepare_neighbors( const tripoint_abs_omt &p )
+{
+    // Distance (in overmap terrain) to the edge of the overmap at which its neighbour is prepared
+    static constexpr int prepare_distance = OMAPX / 4;
+    point_abs_om om_pos;
+    tripoint_om_omt local;
+    std::tie( om_pos, local ) = project_remain<coords::om>( p );
+
+    point dir;
+    if( local.y() < prepare_distance ) {
+        dir.y = -1;
+    } else if( local.y() >= OMAPY - prepare_distance ) {
+        dir.y = 1;
+    }
+    if( local.x() < prepare_distance ) {
+        dir.x = -1;
+    } else if( local.x() >= OMAPX - prepare_distance ) {
+        dir.x = 1;
+    }
+    if( dir == point_zero ) {
+        return false;
+    }
+
+    std::vector<point> offsets;
+    if( dir.y < 0 ) {
+        offsets.push_back( point_north );
+    }
+    if( dir.x > 0 ) {
+        offsets.push_back( point_east );
+    }
+    if( dir.y > 0 ) {
+        offsets.push_back( point_south );
+    }
+    if( dir.x < 0 ) {
+        offsets.push_back( point_west );
+    }
+    // The diagonal neighbour comes last, so it is generated next to both orthogonal ones.
+    if( dir.x != 0 && dir.y != 0 ) {
+        offsets.push_back( dir );
+    }
+    for( const point &offset : offsets ) {
+        const point_abs_om neighbor = om_pos + offset;
+        // has() loads the overmap if it exists on disk, that is as much as we want here.
+        if( !has( neighbor ) ) {
+            get( neighbor );
+            return true;
+        }
+    }
+    return false;
+}
+
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
@@ -181,6 +236,9 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
     // First step: move all npcs that are located outside of the given overmap
     // into a separate container. After that loop, new_overmap.npcs is no
     // accessed anymore!
+    new_overmap.wake_npcs( [&new_overmap]( const dormant_npc & guy ) {
+        return project_to<coords::om>( guy.pos.xy() ) != new_overmap.pos();
+    } );
     decltype( overmap::npcs ) to_relocate;
     for( auto it = new_overmap.npcs.begin(); it != new_overmap.npcs.end(); ) {
         npc &np = **it;
@@ -227,10 +285,18 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
 
 void overmapbuffer::save()
 {
+    int written = 0;
     for( auto &omp : overmaps ) {
+        if( !omp.second->modified_since_save() ) {
+            continue;
+        }
         // Note: this may throw io errors from std::ofstream
         omp.second->save();
+        omp.second->mark_saved();
+        written++;
     }
+    DebugLog( D_INFO, D_MAP ) << "overmapbuffer::save: " << written << " of " << overmaps.size()
+                              << " overmaps written";
 }
 
 void overmapbuffer::reset()
@@ -294,10 +360,12 @@ void overmapbuffer::delete_extra( const tripoint_abs_omt &p )
 overmap *overmapbuffer::get_existing( const point_abs_om &p )
 {
     if( last_requested_overmap && last_requested_overmap->pos() == p ) {
+        last_requested_overmap->mark_modified();
         return last_requested_overmap;
     }
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
+        it->second->mark_modified();
         return last_requested_overmap = it->second.get();
     }
     if( known_non_existing.count( p ) > 0 ) {
@@ -578,6 +646,7 @@ void overmapbuffer::signal_nemesis( const tripoint_abs_sm &p )
 {
 
     for( std::pair<const point_abs_om, std::unique_ptr<overmap>> &omp : overmaps ) {
+        omp.second->mark_modified();
         omp.second->signal_nemesis( p );
     }
 
@@ -616,6 +685,7 @@ void overmapbuffer::move_hordes()
 void overmapbuffer::move_nemesis()
 {
     for( std::pair<const point_abs_om, std::unique_ptr<overmap>> &omp : overmaps ) {
+        omp.second->mark_modified();
         omp.second->move_nemesis();
         fix_nemesis( *omp.second );
     }
@@ -626,6 +696,7 @@ void overmapbuffer::remove_nemesis()
     for( std::pair<const point_abs_om, std::unique_ptr<overmap>> &omp : overmaps ) {
         bool nemesis_removed = omp.second->remove_nemesis();
         if( nemesis_removed ) {
+            omp.second->mark_modified();
             break;
         }
     }
@@ -1102,6 +1173,12 @@ bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
         return false;
     }
 
+    return passes_find_filters( location, params );
+}
+
+bool overmapbuffer::passes_find_filters( const tripoint_abs_omt &location,
+        const omt_find_params &params )
+{
     if( params.must_see && !seen( location ) ) {
         return false;
     }
@@ -1134,6 +1211,85 @@ tripoint_abs_omt overmapbuffer::find_closest(
     return find_closest( origin, params );
 }
 
+// Whether a terrain matches any of the types in params, memoized per terrain.
+static std::function<bool( const oter_id & )> terrain_matcher( const omt_find_params &params )
+{
+    return [&params, memo = std::unordered_map<oter_id, bool>()]( const oter_id & ot ) mutable {
+        const auto found = memo.find( ot );
+        if( found != memo.end() ) {
+            return found->second;
+        }
+        bool result = false;
+        for( const std::pair<std::string, ot_match_type> &elem : params.types ) {
+            if( is_ot_match( elem.first, ot, elem.second ) ) {
+                result = true;
+                break;
+            }
+        }
+        memo.emplace( ot, result );
+        return result;
+    };
+}
+
+// Overmaps that contain points within max_dist (square distance) of origin, paired with
+// the smallest distance of any of their points to origin, closest first.
+static std::vector<std::pair<int, point_abs_om>> overmaps_within( const point_abs_omt &origin,
+        int max_dist )
+{
+    const point_abs_om min_om = project_to<coords::om>( origin - point( max_dist, max_dist ) );
+    const point_abs_om max_om = project_to<coords::om>( origin + point( max_dist, max_dist ) );
+    std::vector<std::pair<int, point_abs_om>> result;
+    for( int x = min_om.x(); x <= max_om.x(); x++ ) {
+        for( int y = min_om.y(); y <= max_om.y(); y++ ) {
+            const point_abs_om om_pos( x, y );
+            const point_abs_omt corner = project_to<coords::omt>( om_pos );
+            const int dx = std::max( { 0, corner.x() - origin.x(), origin.x() - corner.x() - OMAPX + 1 } );
+            const int dy = std::max( { 0, corner.y() - origin.y(), origin.y() - corner.y() - OMAPY + 1 } );
+            result.emplace_back( std::max( dx, dy ), om_pos );
+        }
+    }
+    std::stable_sort( result.begin(), result.end(),
+    []( const std::pair<int, point_abs_om> &a, const std::pair<int, point_abs_om> &b ) {
+        return a.first < b.first;
+    } );
+    return result;
+}
+
+// Locations on om between min_dist and max_dist (square distance in the xy plane) from origin,
+// on the z-levels from min_z to max_z, whose terrain is accepted by matches.
+static void add_matching_terrain( const overmap &om, const point_abs_omt &origin, int min_dist,
+                                  int max_dist, int min_z, int max_z,
+                                  const std::function<bool( const oter_id & )> &matches,
+                                  std::vector<tripoint_abs_omt> &found )
+{
+    for( int z = min_z; z <= max_z; z++ ) {
+        for( const tripoint_om_omt &local : om.find_terrain_matching( z, matches ) ) {
+            const tripoint_abs_omt loc = project_combine( om.pos(), local );
+            const int dist = square_dist( origin, loc.xy() );
+            if( dist >= min_dist && dist <= max_dist ) {
+                found.push_back( loc );
+            }
+        }
+    }
+}
+
+// Position of p (relative to the center) among the points at the same square distance
+// from the center, in the order closest_points_first visits them.
+static int ring_order( const point &p )
+{
+    const int r = std::max( std::abs( p.x ), std::abs( p.y ) );
+    if( p.x == r && p.y > -r ) {
+        return p.y + r - 1;
+    }
+    if( p.y == r ) {
+        return 3 * r - 1 - p.x;
+    }
+    if( p.x == -r ) {
+        return 5 * r - 1 - p.y;
+    }
+    return 7 * r - 1 + p.x;
+}
+
 tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
@@ -1159,29 +1315,35 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
     // and each additional one expends the search to the next concentric circle of overmaps.
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX * 5;
+    const std::function<bool( const oter_id & )> matches = terrain_matcher( params );
 
     std::vector<tripoint_abs_omt> result;
     int found_dist = std::numeric_limits<int>::max();
+    std::vector<tripoint_abs_omt> candidates;
 
-    for( const point_abs_omt &loc_xy : closest_points_first( origin.xy(), min_dist, max_dist ) ) {
-        const int dist_xy = square_dist( origin.xy(), loc_xy );
-
-        if( found_dist < dist_xy ) {
+    // Overmaps are visited closest first, so the ones further away than the best match so far
+    // don't have to be looked at (or created).
+    for( const std::pair<int, point_abs_om> &om_dist : overmaps_within( origin.xy(), max_dist ) ) {
+        if( found_dist < om_dist.first ) {
             break;
         }
-
-        for( int z = params.min_z; z <= params.max_z; z++ ) {
-            const tripoint_abs_omt loc( loc_xy, z );
+        overmap *om = params.existing_only ? get_existing( om_dist.second ) : &get( om_dist.second );
+        if( om == nullptr ) {
+            continue;
+        }
+        candidates.clear();
+        add_matching_terrain( *om, origin.xy(), min_dist, max_dist, params.min_z, params.max_z,
+                              matches, candidates );
+        for( const tripoint_abs_omt &loc : candidates ) {
             const int dist = square_dist( origin, loc );
-
-            if( found_dist < dist ) {
+            if( found_dist < dist || !passes_find_filters( loc, params ) ) {
                 continue;
             }
-
-            if( is_findable_location( loc, params ) ) {
+            if( dist < found_dist ) {
                 found_dist = dist;
-                result.push_back( loc );
+                result.clear();
             }
+            result.push_back( loc );
         }
     }
 
@@ -1195,12 +1357,33 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
     // dist == 0 means search a whole overmap diameter.
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX;
-
-    for( const tripoint_abs_omt &loc : closest_points_first( origin, min_dist, max_dist ) ) {
-        if( is_findable_location( loc, params ) ) {
+    const std::function<bool( const oter_id & )> matches = terrain_matcher( params );
+
+    std::vector<tripoint_abs_omt> candidates;
+    for( const std::pair<int, point_abs_om> &om_dist : overmaps_within( origin.xy(), max_dist ) ) {
+        overmap *om = params.existing_only ? get_existing( om_dist.second ) : &get( om_dist.second );
+        if( om != nullptr ) {
+            add_matching_terrain( *om, origin.xy(), min_dist, max_dist, origin.z(), origin.z(),
+                                  matches, candidates );
+        }
+    }
+    for( const tripoint_abs_omt &loc : candidates ) {
+        if( passes_find_filters( loc, params ) ) {
             result.push_back( loc );
         }
     }
+    // Same order as walking closest_points_first( origin, min_dist, max_dist ).
+    std::sort( result.begin(), result.end(),
+    [&origin]( const tripoint_abs_omt & a, const tripoint_abs_omt & b ) {
+        const point rel_a = ( a.xy() - origin.xy() ).raw();
+        const point rel_b = ( b.xy() - origin.xy() ).raw();
+        const int dist_a = square_dist( point_zero, rel_a );
+        const int dist_b = square_dist( point_zero, rel_b );
+        if( dist_a != dist_b ) {
+            return dist_a < dist_b;
+        }
+        return ring_order( rel_a ) < ring_order( rel_b );
+    } );
 
     return result;
 }
@@ -1244,7 +1427,7 @@ shared_ptr_fast<npc> overmapbuffer::find_npc( character_id id )
 void overmapbuffer::foreach_npc( const std::function<void( npc & )> &callback )
 {
     for( auto &it : overmaps ) {
-        for( auto &guy : it.second->npcs ) {
+        for( const auto &guy : it.second->get_npcs() ) {
             callback( *guy );
         }
     }
@@ -1283,6 +1466,7 @@ shared_ptr_fast<npc> overmapbuffer::remove_npc( const character_id &id )
 {
     for( auto &it : overmaps ) {
         if( auto p = it.second->erase_npc( id ) ) {
+            it.second->mark_modified();
             return p;
         }
     }
@@ -1295,6 +1479,17 @@ std::vector<shared_ptr_fast<npc>> overmapbuffer::get_npcs_near_player( int radiu
     return get_npcs_near( get_player_character().global_sm_location(), radius );
 }
 
+std::vector<shared_ptr_fast<npc>> overmapbuffer::get_npcs_near_player( int radius,
+                               npc_mission mission )
+{
+    return get_npcs_near( get_player_character().global_sm_location(), radius,
+    [mission]( const dormant_npc & guy ) {
+        return guy.mission == mission;
+    }, [mission]( const npc & guy ) {
+        return guy.mission == mission;
+    } );
+}
+
 std::vector<overmap *> overmapbuffer::get_overmaps_near( const tripoint_abs_sm &location,
         const int radius )
 {
@@ -1332,27 +1527,43 @@ std::vector<overmap *> overmapbuffer::get_overmaps_near( const point_abs_sm &p,
 
 std::vector<shared_ptr_fast<npc>> overmapbuffer::get_companion_mission_npcs( int range )
 {
-    std::vector<shared_ptr_fast<npc>> available;
     // TODO: this is an arbitrary radius, replace with something sane.
-    for( const auto &guy : get_npcs_near_player( range ) ) {
-        if( guy->has_companion_mission() ) {
-            available.push_back( guy );
-        }
-    }
-    return available;
+    return get_npcs_near( get_player_character().global_sm_location(), range,
+    []( const dormant_npc & guy ) {
+        return guy.companion_mission;
+    }, []( const npc & guy ) {
+        return guy.has_companion_mission();
+    } );
 }
 
 std::vector<shared_ptr_fast<npc>> overmapbuffer::get_npcs_near( const tripoint_abs_sm &p,
                                int radius )
+{
+    return get_npcs_near( p, radius, []( const dormant_npc & ) {
+        return true;
+    }, []( const npc & ) {
+        return true;
+    } );
+}
+
+std::vector<shared_ptr_fast<npc>> overmapbuffer::get_npcs_near( const tripoint_abs_sm &p,
+                               int radius,
+                               const std::function<bool( const dormant_npc & )> &wake_if,
+                               const std::function<bool( const npc & )> &predicate )
 {
     std::vector<shared_ptr_fast<npc>> result;
     for( overmap *&it : get_overmaps_near( p.xy(), radius ) ) {
-        auto temp = it->get_npcs( [&]( const npc & guy ) {
-            // Global position of NPC, in submap coordinates
-            const tripoint_abs_sm pos = guy.global_sm_location();
-            return square_dist( p.xy(), pos.xy() ) <= radius;
+        it->wake_npcs( [&]( const dormant_npc & guy ) {
+            const tripoint_abs_sm pos = project_to<coords::sm>( guy.pos );
+            return square_dist( p.xy(), pos.xy() ) <= radius && wake_if( guy );
         } );
-        result.insert( result.end(), temp.begin(), temp.end() );
+        for( const shared_ptr_fast<npc> &guy : it->npcs ) {
+            // Global position of NPC, in submap coordinates
+            const tripoint_abs_sm pos = guy->global_sm_location();
+            if( square_dist( p.xy(), pos.xy() ) <= radius && predicate( *guy ) ) {
+                result.push_back( guy );
+            }
+        }
     }
     return result;
 }
@@ -1362,12 +1573,16 @@ std::vector<shared_ptr_fast<npc>> overmapbuffer::get_npcs_near_omt( const tripoi
 {
     std::vector<shared_ptr_fast<npc>> result;
     for( overmap *&it : get_overmaps_near( project_to<coords::sm>( p.xy() ), radius ) ) {
-        auto temp = it->get_npcs( [&]( const npc & guy ) {
-            // Global position of NPC, in submap coordinates
-            tripoint_abs_omt pos = guy.global_omt_location();
-            return square_dist( p.xy(), pos.xy() ) <= radius;
+        it->wake_npcs( [&]( const dormant_npc & guy ) {
+            return square_dist( p.xy(), project_to<coords::omt>( guy.pos.xy() ) ) <= radius;
         } );
-        result.insert( result.end(), temp.begin(), temp.end() );
+        for( const shared_ptr_fast<npc> &guy : it->npcs ) {
+            // Global position of NPC, in overmap terrain coordinates
+            const tripoint_abs_omt pos = guy->global_omt_location();
+            if( square_dist( p.xy(), pos.xy() ) <= radius ) {
+                result.push_back( guy );
+            }
+        }
     }
     return result;
 }
@@ -1440,7 +1655,7 @@ std::vector<shared_ptr_fast<npc>> overmapbuffer::get_overmap_npcs()
     std::vector<shared_ptr_fast<npc>> result;
     for( auto &om : overmaps ) {
         const overmap &overmap = *om.second;
-        for( const auto &guy : overmap.npcs ) {
+        for( const auto &guy : overmap.get_npcs() ) {
             result.push_back( guy );
         }
     }
@@ -25,12 +25,14 @@
 class basecamp;
 class character_id;
 enum class cube_direction : int;
+enum npc_mission : int;
 class map_extra;
 class monster;
 class npc;
 class overmap;
 class overmap_special_batch;
 class vehicle;
+struct dormant_npc;
 struct mapgen_arguments;
 struct mongroup;
 struct om_vehicle;
@@ -163,6 +165,16 @@ class overmapbuffer
         void reset();
         void clear();
         void create_custom_overmap( const point_abs_om &, overmap_special_batch &specials );
+        /**
+         * If @p p is close to the edge of its overmap, load or generate the first missing
+         * neighbour overmap on that side (at most one per call).
+         * Meant to be called periodically, so the overmap the player walks towards already
+         * exists when the map needs it instead of being generated while the map shifts.
+         * Neighbours are created in a fixed order (north, east, south, west, then the diagonal)
+         * so which neighbours a new overmap sees during generation only depends on @p p.
+         * @returns true if an overmap was created.
+         */
+        bool prepare_neighbors( const tripoint_abs_omt &p );
 
         /**
          * Returns the overmap terrain at the given OMT coordinates.
@@ -287,6 +299,11 @@ class overmapbuffer
          * player position as center.
          */
         std::vector<shared_ptr_fast<npc>> get_npcs_near_player( int radius );
+        /**
+         * Same as @ref get_npcs_near_player(int), but only the npcs on @p mission. Dormant npcs
+         * on other missions aren't woken.
+         */
+        std::vector<shared_ptr_fast<npc>> get_npcs_near_player( int radius, npc_mission mission );
         /**
          * Find the npc with the given ID.
          * Returns NULL if the npc could not be found.
@@ -545,6 +562,11 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
+        /**
+         * The part of @ref is_findable_location that does not depend on the terrain type,
+         * for locations already known to have one of the requested types.
+         */
+        bool passes_find_filters( const tripoint_abs_omt &location, const omt_find_params &params );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
         /**
@@ -644,6 +666,14 @@ class overmapbuffer
          */
         std::vector<overmap *> get_overmaps_near( const point_abs_sm &p, int radius );
         std::vector<overmap *> get_overmaps_near( const tripoint_abs_sm &location, int radius );
+        /**
+         * The npcs for which @p predicate is true within @p radius of @p p, like
+         * @ref get_npcs_near. Of the dormant npcs there, only those @p wake_if is true for are
+         * woken and considered.
+         */
+        std::vector<shared_ptr_fast<npc>> get_npcs_near( const tripoint_abs_sm &p, int radius,
+                                       const std::function<bool( const dormant_npc & )> &wake_if,
+                                       const std::function<bool( const npc & )> &predicate );
 };
 
 extern overmapbuffer overmap_buffer;
@@ -15,6 +15,7 @@
 #include "input.h"
 #include "item.h"
 #include "item_factory.h"
+#include "item_group.h"
 #include "itype.h"
 #include "make_static.h"
 #include "mapgen.h"
@@ -166,10 +167,42 @@ std::vector<const recipe *> recipe_subset::recent() const
     return res;
 }
 
+// Recipes of the subset listed under the index entries whose name matches txt.
+template<typename Index>
+static std::vector<const recipe *> search_index( const std::set<const recipe *> &subset,
+        const Index &index, const std::string_view txt )
+{
+    std::vector<const recipe *> res;
+    for( const auto &entry : index ) {
+        if( !lcmatch( entry.first->name(), txt ) ) {
+            continue;
+        }
+        for( const recipe *r : entry.second ) {
+            if( subset.count( r ) > 0 ) {
+                res.push_back( r );
+            }
+        }
+    }
+    std::sort( res.begin(), res.end() );
+    res.erase( std::unique( res.begin(), res.end() ), res.end() );
+    return res;
+}
+
 std::vector<const recipe *> recipe_subset::search(
     const std::string_view txt, const search_type key,
     const std::function<void( size_t, size_t )> &progress_callback ) const
 {
+    switch( key ) {
+        case search_type::skill:
+            return search_index( recipes, recipe_dict.recipes_by_skill( false ), txt );
+        case search_type::primary_skill:
+            return search_index( recipes, recipe_dict.recipes_by_skill( true ), txt );
+        case search_type::proficiency:
+            return search_index( recipes, recipe_dict.recipes_by_proficiency(), txt );
+        default:
+            break;
+    }
+
     auto predicate = [&]( const recipe * r ) {
         if( !*r || r->obsolete ) {
             return false;
@@ -333,14 +366,30 @@ recipe_subset recipe_subset::difference( const std::set<const recipe *> &recipe_
 std::vector<const recipe *> recipe_subset::recipes_that_produce( const itype_id &item ) const
 {
     std::vector<const recipe *> res;
+    const std::vector<const recipe *> &producing = recipe_dict.recipes_producing( item );
 
-    std::copy_if( recipes.begin(), recipes.end(), std::back_inserter( res ), [&]( const recipe * r ) {
-        return !r->obsolete && ( item == r->result() || r->in_byproducts( item ) );
+    std::copy_if( producing.begin(), producing.end(), std::back_inserter( res ),
+    [this]( const recipe * r ) {
+        return recipes.count( r ) > 0;
     } );
 
     return res;
 }
 
+bool recipe_subset::contains( const recipe *r ) const
+{
+    if( recipes.count( r ) > 0 ) {
+        return true;
+    }
+    // r may be a copy of a recipe (e.g. a disassembly), those are matched by id
+    if( r->ident().is_valid() && &r->ident().obj() == r ) {
+        return false;
+    }
+    return std::any_of( recipes.begin(), recipes.end(), [r]( const recipe * elem ) {
+        return elem->ident() == r->ident();
+    } );
+}
+
 bool recipe_subset::empty_category( const std::string &cat, const std::string &subcat ) const
 {
     if( subcat == "CSC_*_FAVORITE" ) {
@@ -666,11 +715,101 @@ void recipe_dictionary::finalize()
         if( e.second.is_blueprint() ) {
             recipe_dict.blueprints.insert( &e.second );
         }
+        if( !e.second.obsolete ) {
+            recipe_dict.index_recipe( e.second );
+        }
     }
+    recipe_dict.sort_indexes();
 
     recipe_dict.find_items_on_loops();
 }
 
+void recipe_dictionary::index_recipe( const recipe &r )
+{
+    add_requirement_users( r, r.simple_requirements() );
+    for( const requirement_data &req : r.deduped_requirements().alternatives() ) {
+        add_requirement_users( r, req );
+    }
+
+    producing[r.result()].push_back( &r );
+    for( const std::pair<const itype_id, int> &bp : r.byproducts ) {
+        producing[bp.first].push_back( &r );
+    }
+    if( r.byproduct_group ) {
+        for( const itype *bp : item_group::every_possible_item_from( *r.byproduct_group ) ) {
+            producing[bp->get_id()].push_back( &r );
+        }
+    }
+
+    if( r.skill_used ) {
+        by_primary_skill[r.skill_used].push_back( &r );
+        by_skill[r.skill_used].push_back( &r );
+    }
+    for( const std::pair<const skill_id, int> &sk : r.required_skills ) {
+        by_skill[sk.first].push_back( &r );
+    }
+    for( const recipe_proficiency &prof : r.proficiencies ) {
+        by_proficiency[prof.id].push_back( &r );
+    }
+}
+
+template<typename Index>
+static void sort_index( Index &index )
+{
+    for( auto &entry : index ) {
+        std::vector<const recipe *> &list = entry.second;
+        std::sort( list.begin(), list.end() );
+        list.erase( std::unique( list.begin(), list.end() ), list.end() );
+    }
+}
+
+void recipe_dictionary::sort_indexes()
+{
+    sort_index( producing );
+    sort_index( by_primary_skill );
+    sort_index( by_skill );
+    sort_index( by_proficiency );
+}
+
+const std::vector<const recipe *> &recipe_dictionary::recipes_producing( const itype_id &id ) const
+{
+    static const std::vector<const recipe *> no_recipes;
+    const auto iter = producing.find( id );
+    return iter != producing.end() ? iter->second : no_recipes;
+}
+
+void recipe_dictionary::add_requirement_users( const recipe &r, const requirement_data &req )
+{
+    for( const std::vector<item_comp> &comps : req.get_components() ) {
+        for( const item_comp &comp : comps ) {
+            using_item[comp.type].insert( &r );
+        }
+    }
+    for( const std::vector<tool_comp> &tools : req.get_tools() ) {
+        for( const tool_comp &tool : tools ) {
+            using_item[tool.type].insert( &r );
+        }
+    }
+    for( const std::vector<quality_requirement> &quals : req.get_qualities() ) {
+        for( const quality_requirement &qual : quals ) {
+            using_quality[qual.type].insert( &r );
+        }
+    }
+}
+
+const std::set<const recipe *> &recipe_dictionary::recipes_using_item( const itype_id &id ) const
+{
+    const auto iter = using_item.find( id );
+    return iter != using_item.end() ? iter->second : null_match;
+}
+
+const std::set<const recipe *> &recipe_dictionary::recipes_using_quality(
+    const quality_id &id ) const
+{
+    const auto iter = using_quality.find( id );
+    return iter != using_quality.end() ? iter->second : null_match;
+}
+
 void recipe_dictionary::check_consistency()
 {
     for( const auto &e : recipe_dict.recipes ) {
@@ -719,6 +858,13 @@ void recipe_dictionary::reset()
     recipe_dict.recipes.clear();
     recipe_dict.uncraft.clear();
     recipe_dict.items_on_loops.clear();
+    recipe_dict.using_item.clear();
+    recipe_dict.using_quality.clear();
+    recipe_dict.producing.clear();
+    recipe_dict.by_primary_skill.clear();
+    recipe_dict.by_skill.clear();
+    recipe_dict.by_proficiency.clear();
+    recipe_dict.generation++;
     for( std::pair<JsonObject, std::string> &deferred_json : deferred ) {
         deferred_json.first.allow_omitted_members();
     }
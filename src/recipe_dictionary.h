@@ -42,6 +42,33 @@ class recipe_dictionary
 
         std::map<recipe_id, const recipe *> find_obsoletes( const itype_id &item_id ) const;
 
+        /** Returns recipes whose requirements use the item as a component or tool */
+        const std::set<const recipe *> &recipes_using_item( const itype_id &id ) const;
+        /** Returns recipes whose requirements need the tool quality */
+        const std::set<const recipe *> &recipes_using_quality( const quality_id &id ) const;
+        /** Returns recipes producing the item as their result or a byproduct, sorted by address */
+        const std::vector<const recipe *> &recipes_producing( const itype_id &id ) const;
+        /**
+         * Returns recipes by the skills they use, sorted by address.
+         * @param primary_only only index recipes under their primary skill
+         */
+        const std::map<skill_id, std::vector<const recipe *>> &recipes_by_skill(
+            bool primary_only ) const {
+            return primary_only ? by_primary_skill : by_skill;
+        }
+        /** Returns recipes by the proficiencies they involve, sorted by address */
+        const std::map<proficiency_id, std::vector<const recipe *>> &recipes_by_proficiency() const {
+            return by_proficiency;
+        }
+
+        /**
+         * Changes every time the recipes are unloaded.
+         * Pointers to recipes kept from an earlier generation are dangling.
+         */
+        int get_generation() const {
+            return generation;
+        }
+
         size_t size() const;
         std::map<recipe_id, recipe>::const_iterator begin() const;
         std::map<recipe_id, recipe>::const_iterator end() const;
@@ -78,8 +105,21 @@ class recipe_dictionary
         std::set<const recipe *> autolearn;
         std::set<const recipe *> nested;
         std::set<const recipe *> blueprints;
-        std::map<const itype_id, const recipe *> obsoletes;
+        std::multimap<itype_id, const recipe *> obsoletes;
         std::unordered_set<itype_id> items_on_loops;
+        std::map<itype_id, std::set<const recipe *>> using_item;
+        std::map<quality_id, std::set<const recipe *>> using_quality;
+        std::map<itype_id, std::vector<const recipe *>> producing;
+        std::map<skill_id, std::vector<const recipe *>> by_primary_skill;
+        std::map<skill_id, std::vector<const recipe *>> by_skill;
+        std::map<proficiency_id, std::vector<const recipe *>> by_proficiency;
+        int generation = 0;
+
+        void add_requirement_users( const recipe &r, const requirement_data &req );
+        /** Adds a (not obsolete) recipe to the secondary indexes */
+        void index_recipe( const recipe &r );
+        /** Sorts the secondary indexes once all recipes are in */
+        void sort_indexes();
 
         static void finalize_internal( std::map<recipe_id, recipe> &obj );
         void find_items_on_loops();
@@ -115,11 +155,7 @@ class recipe_subset
         }
 
         /** Check if the subset contains a recipe with the specified id. */
-        bool contains( const recipe *r ) const {
-            return std::any_of( recipes.begin(), recipes.end(), [r]( const recipe * elem ) {
-                return elem->ident() == r->ident();
-            } );
-        }
+        bool contains( const recipe *r ) const;
 
         /**
          * Get custom difficulty for the recipe.
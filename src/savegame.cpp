@@ -28,6 +28,7 @@
 #include "map.h"
 #include "messages.h"
 #include "mission.h"
+#include "mission_companion.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "npc.h"
@@ -400,6 +401,51 @@ void overmap::load_legacy_monstergroups( const JsonArray &jsin )
 }
 
 // throws std::exception
+static dormant_npc make_dormant_npc( const JsonObject &jo )
+{
+    dormant_npc guy;
+    guy.json = jo.to_json_text();
+    jo.allow_omitted_members();
+    jo.read( "id", guy.id );
+    jo.read( "unique_id", guy.unique_id );
+    jo.read( "location", guy.pos );
+    int mission = 0;
+    if( jo.read( "mission", mission ) ) {
+        guy.mission = static_cast<npc_mission>( mission );
+    }
+    mission_id comp_mission;
+    jo.read( "comp_mission_id", comp_mission );
+    guy.companion_mission = comp_mission.id != No_Mission;
+
+    // Factions don't save their members, npcs add themselves when loaded (npc::set_fac).
+    std::string fac_id;
+    if( jo.read( "my_fac", fac_id ) ) {
+        if( faction *fac = g->faction_manager_ptr->get( faction_id( fac_id ), false ) ) {
+            std::string name;
+            bool known_to_u = false;
+            jo.read( "name", name );
+            jo.read( "known_to_u", known_to_u );
+            fac->add_to_membership( guy.id, name, known_to_u );
+        }
+    }
+    return guy;
+}
+
+shared_ptr_fast<npc> dormant_npc::wake() const
+{
+    shared_ptr_fast<npc> guy = make_shared_fast<npc>();
+    try {
+        guy->deserialize( json_loader::from_string( json ).get_object() );
+    } catch( const JsonError &err ) {
+        debugmsg( "Failed to load NPC %d: %s", id.get_value(), err.what() );
+        return nullptr;
+    }
+    if( !guy->get_fac_id().str().empty() ) {
+        guy->set_fac( guy->get_fac_id() );
+    }
+    return guy;
+}
+
 void overmap::unserialize( const cata_path &file_name, std::istream &fin )
 {
     size_t json_offset = chkversion( fin );
@@ -429,40 +475,52 @@ void overmap::unserialize( const JsonObject &jsobj )
 
         for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
             JsonArray layer_json = layers_json.next_array();
-            int count = 0;
-            std::string tmp_ter;
+            // Keep the runs as they are, the layer is only expanded when its terrain is needed.
+            std::vector<std::pair<oter_id, int>> &runs = layer[z].terrain_runs;
+            layer[z].terrain.reset();
+            runs.clear();
+            terrain_index_valid[z] = false;
             oter_id tmp_otid( 0 );
-            for( int j = 0; j < OMAPY; j++ ) {
-                for( int i = 0; i < OMAPX; i++ ) {
-                    if( count == 0 ) {
-                        {
-                            JsonArray rle_terrain = layer_json.next_array();
-                            tmp_ter = rle_terrain.next_string();
-                            count = rle_terrain.next_int();
-                            if( rle_terrain.has_more() ) {
-                                rle_terrain.throw_error( 2, "Unexpected value in RLE encoding" );
-                            }
-                        }
-                        if( is_oter_id_obsolete( tmp_ter ) ) {
-                            for( int p = i; p < i + count; p++ ) {
-                                oter_id_migrations.emplace( tripoint_om_omt( p, j, z - OVERMAP_DEPTH ), tmp_ter );
-                            }
-                        } else if( oter_str_id( tmp_ter ).is_valid() ) {
-                            tmp_otid = oter_id( tmp_ter );
-                        } else {
-                            debugmsg( "Loaded invalid oter_id '%s'", tmp_ter.c_str() );
-                            tmp_otid = oter_omt_obsolete;
-                        }
-                        if( oter_id_should_have_camp( oter_str_id( tmp_ter )->get_type_id() ) ) {
-                            for( int p = i; p < i + count; p++ ) {
-                                camps_to_place.emplace_back( project_combine( pos(), tripoint_om_omt( p, j, z - OVERMAP_DEPTH ) ) );
-                            }
-                        }
+            for( int offset = 0; offset < OMAPX * OMAPY; ) {
+                std::string tmp_ter;
+                int count = 0;
+                {
+                    JsonArray rle_terrain = layer_json.next_array();
+                    tmp_ter = rle_terrain.next_string();
+                    count = rle_terrain.next_int();
+                    if( count < 1 ) {
+                        rle_terrain.throw_error( 1, "Invalid count in RLE encoding" );
                     }
-                    count--;
-                    layer[z].terrain[i][j] = tmp_otid;
+                    if( rle_terrain.has_more() ) {
+                        rle_terrain.throw_error( 2, "Unexpected value in RLE encoding" );
+                    }
+                    count = std::min( count, OMAPX * OMAPY - offset );
+                }
+                if( is_oter_id_obsolete( tmp_ter ) ) {
+                    for( int p = offset; p < offset + count; p++ ) {
+                        oter_id_migrations.emplace( tripoint_om_omt( p % OMAPX, p / OMAPX, z - OVERMAP_DEPTH ),
+                                                    tmp_ter );
+                    }
+                } else if( oter_str_id( tmp_ter ).is_valid() ) {
+                    tmp_otid = oter_id( tmp_ter );
+                } else {
+                    debugmsg( "Loaded invalid oter_id '%s'", tmp_ter.c_str() );
+                    tmp_otid = oter_omt_obsolete;
                 }
+                if( oter_id_should_have_camp( oter_str_id( tmp_ter )->get_type_id() ) ) {
+                    for( int p = offset; p < offset + count; p++ ) {
+                        camps_to_place.emplace_back( project_combine( pos(),
+                                                     tripoint_om_omt( p % OMAPX, p / OMAPX, z - OVERMAP_DEPTH ) ) );
+                    }
+                }
+                if( !runs.empty() && runs.back().first == tmp_otid ) {
+                    runs.back().second += count;
+                } else {
+                    runs.emplace_back( tmp_otid, count );
+                }
+                offset += count;
             }
+            runs.shrink_to_fit();
         }
         migrate_oter_ids( oter_id_migrations );
         migrate_camps( camps_to_place );
@@ -611,12 +669,18 @@ void overmap::unserialize( const JsonObject &jsobj )
         } else if( name == "npcs" ) {
             JsonArray npcs_json = om_member;
             for( JsonObject npc_json : npcs_json ) {
-                shared_ptr_fast<npc> new_npc = make_shared_fast<npc>();
-                new_npc->deserialize( npc_json );
-                if( !new_npc->get_fac_id().str().empty() ) {
-                    new_npc->set_fac( new_npc->get_fac_id() );
+                // TEMPORARY Remove if branch after 0.G (keep else branch)
+                if( !npc_json.has_member( "location" ) ) {
+                    // The position needs the whole legacy conversion of npc::load.
+                    shared_ptr_fast<npc> new_npc = make_shared_fast<npc>();
+                    new_npc->deserialize( npc_json );
+                    if( !new_npc->get_fac_id().str().empty() ) {
+                        new_npc->set_fac( new_npc->get_fac_id() );
+                    }
+                    npcs.push_back( new_npc );
+                } else {
+                    dormant_npcs.push_back( make_dormant_npc( npc_json ) );
                 }
-                npcs.push_back( new_npc );
             }
         } else if( name == "camps" ) {
             JsonArray camps_json = om_member;
@@ -734,7 +798,7 @@ void overmap::unserialize( const JsonObject &jsobj )
                     for( size_t i = 1; i < serialized_predecessors.size(); ++i ) {
                         local_set_ter( serialized_predecessors[i] );
                     }
-                    local_set_ter( layer[p.z() + OVERMAP_DEPTH].terrain[p.xy()] );
+                    local_set_ter( layer_terrain( p.z() + OVERMAP_DEPTH )[p.xy()] );
                 }
                 predecessors_.insert_or_assign( p, std::move( om_predecessors ) );
 
@@ -771,6 +835,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
             debugmsg( "Loaded invalid overmap from omap file %s. Loaded %s, expected %s",
                       json_path.generic_u8string(), om_pos.to_string(), pos().to_string() );
         } else {
+            map_layer::terrain_array &terrain = layer_terrain( z + OVERMAP_DEPTH );
             int count = 0;
             std::string tmp_ter;
             oter_id tmp_otid( 0 );
@@ -792,7 +857,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                         }
                     }
                     count--;
-                    layer[z + OVERMAP_DEPTH].terrain[i][j] = tmp_otid;
+                    terrain[i][j] = tmp_otid;
                     if( tmp_otid == oter_lake_shore || tmp_otid == oter_lake_surface ) {
                         lake_points.emplace_back( i, j, z );
                     }
@@ -836,7 +901,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                 ter_set( tripoint_om_omt( p.xy(), z ), oter_lake_water_cube );
             }
             ter_set( tripoint_om_omt( p.xy(), settings->overmap_lake.lake_depth ), oter_lake_bed );
-            layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = oter_lake_surface;
+            layer_terrain( p.z() + OVERMAP_DEPTH )[p.xy()] = oter_lake_surface;
         }
     }
     std::unordered_set<tripoint_om_omt> ocean_set;
@@ -866,7 +931,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                 ter_set( tripoint_om_omt( p.xy(), z ), oter_ocean_water_cube );
             }
             ter_set( tripoint_om_omt( p.xy(), settings->overmap_ocean.ocean_depth ), oter_ocean_bed );
-            layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = oter_ocean_surface;
+            layer_terrain( p.z() + OVERMAP_DEPTH )[p.xy()] = oter_ocean_surface;
         }
     }
     std::unordered_set<tripoint_om_omt> forest_set;
@@ -1035,7 +1100,7 @@ void overmap::serialize_view( std::ostream &fout ) const
         json.start_array();
         serialize_array_to_compacted_sequence( json, layer[z].visible );
         json.end_array();
-        fout << std::endl;
+        json.get_stream()->put( '\n' );
     }
     json.end_array();
 
@@ -1045,7 +1110,7 @@ void overmap::serialize_view( std::ostream &fout ) const
         json.start_array();
         serialize_array_to_compacted_sequence( json, layer[z].explored );
         json.end_array();
-        fout << std::endl;
+        json.get_stream()->put( '\n' );
     }
     json.end_array();
 
@@ -1061,7 +1126,7 @@ void overmap::serialize_view( std::ostream &fout ) const
             json.write( i.dangerous );
             json.write( i.danger_radius );
             json.end_array();
-            fout << std::endl;
+            json.get_stream()->put( '\n' );
         }
         json.end_array();
     }
@@ -1077,7 +1142,7 @@ void overmap::serialize_view( std::ostream &fout ) const
             json.write( i.p.y() );
             json.write( i.id );
             json.end_array();
-            fout << std::endl;
+            json.get_stream()->put( '\n' );
         }
         json.end_array();
     }
@@ -1155,44 +1220,61 @@ void overmap::serialize( std::ostream &fout ) const
     json.member( "layers" );
     json.start_array();
     for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-        const auto &layer_terrain = layer[z].terrain;
-        int count = 0;
-        oter_id last_tertype( -1 );
+        const map_layer &l = layer[z];
         json.start_array();
-        for( int j = 0; j < OMAPY; j++ ) {
-            // NOLINTNEXTLINE(modernize-loop-convert)
-            for( int i = 0; i < OMAPX; i++ ) {
-                oter_id t = layer_terrain[i][j];
-                if( t != last_tertype ) {
-                    if( count ) {
-                        json.write( count );
-                        json.end_array();
+        if( !l.terrain ) {
+            // Never expanded, so it is still exactly what was loaded (or all default terrain).
+            if( l.terrain_runs.empty() ) {
+                json.start_array();
+                json.write( get_default_terrain( z - OVERMAP_DEPTH ).id() );
+                json.write( OMAPX * OMAPY );
+                json.end_array();
+            }
+            for( const std::pair<oter_id, int> &run : l.terrain_runs ) {
+                json.start_array();
+                json.write( run.first.id() );
+                json.write( run.second );
+                json.end_array();
+            }
+        } else {
+            const map_layer::terrain_array &layer_terrain = *l.terrain;
+            int count = 0;
+            oter_id last_tertype( -1 );
+            for( int j = 0; j < OMAPY; j++ ) {
+                // NOLINTNEXTLINE(modernize-loop-convert)
+                for( int i = 0; i < OMAPX; i++ ) {
+                    oter_id t = layer_terrain[i][j];
+                    if( t != last_tertype ) {
+                        if( count ) {
+                            json.write( count );
+                            json.end_array();
+                        }
+                        last_tertype = t;
+                        json.start_array();
+                        json.write( t.id() );
+                        count = 1;
+                    } else {
+                        count++;
                     }
-                    last_tertype = t;
-                    json.start_array();
-                    json.write( t.id() );
-                    count = 1;
-                } else {
-                    count++;
                 }
             }
+            json.write( count );
+            // End the last entry for a z-level.
+            json.end_array();
         }
-        json.write( count );
-        // End the last entry for a z-level.
-        json.end_array();
         // End the z-level
         json.end_array();
         // Insert a newline occasionally so the file isn't totally unreadable.
-        fout << std::endl;
+        json.get_stream()->put( '\n' );
     }
     json.end_array();
 
     // temporary, to allow user to manually switch regions during play until regionmap is done.
     json.member( "region_id", settings->id );
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     save_monster_groups( json );
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.member( "cities" );
     json.start_array();
@@ -1208,10 +1290,10 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.member( "connections_out", connections_out );
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.member( "radios" );
     json.start_array();
@@ -1226,7 +1308,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.member( "monster_map" );
     json.start_array();
@@ -1235,7 +1317,7 @@ void overmap::serialize( std::ostream &fout ) const
         i.second.serialize( json );
     }
     json.end_array();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.member( "tracked_vehicles" );
     json.start_array();
@@ -1248,7 +1330,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.member( "scent_traces" );
     json.start_array();
@@ -1260,15 +1342,21 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.member( "npcs" );
     json.start_array();
     for( const auto &i : npcs ) {
         json.write( *i );
     }
+    for( const dormant_npc &guy : dormant_npcs ) {
+        // Unchanged since loading, so this is what the npc would write.
+        json.write_separator();
+        *json.get_stream() << guy.json;
+        json.set_need_separator();
+    }
     json.end_array();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.member( "camps" );
     json.start_array();
@@ -1276,7 +1364,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.write( i );
     }
     json.end_array();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     // Condense the overmap special placements so that all placements of a given special
     // are grouped under a single key for that special.
@@ -1309,10 +1397,10 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.member( "mapgen_arg_storage", mapgen_arg_storage );
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
     json.member( "mapgen_arg_index" );
     json.start_array();
     for( const std::pair<const tripoint_om_omt, std::optional<mapgen_arguments> *> &p :
@@ -1325,20 +1413,20 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_array();
     }
     json.end_array();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     std::vector<std::pair<om_pos_dir, std::string>> flattened_joins_used(
                 joins_used.begin(), joins_used.end() );
     json.member( "joins_used", flattened_joins_used );
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     std::vector<std::pair<tripoint_om_omt, std::vector<oter_id>>> flattened_predecessors(
         predecessors_.begin(), predecessors_.end() );
     json.member( "predecessors", flattened_predecessors );
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 
     json.end_object();
-    fout << std::endl;
+    json.get_stream()->put( '\n' );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -1506,12 +1594,8 @@ void global_variables::unserialize( JsonObject &jo )
 {
     jo.read( "global_vals", global_values );
     // potentially migrate some variable names
-    for( std::pair<std::string, std::string> migration : migrations ) {
-        if( global_values.count( migration.first ) != 0 ) {
-            auto extracted = global_values.extract( migration.first );
-            extracted.key() = migration.second;
-            global_values.insert( std::move( extracted ) );
-        }
+    for( const std::pair<const std::string, std::string> &migration : migrations ) {
+        global_values.rename( migration.first, migration.second );
     }
 }
 
@@ -826,6 +826,7 @@ void Character::load( const JsonObject &data )
     for( const std::pair<const trait_id, trait_data> &add : muts_to_add ) {
         my_mutations.emplace( add.first, add.second );
     }
+    rebuild_trait_bits();
     // We need to ensure that my_mutations contains no invalid mutations before we do this
     // As every time we add a mutation, we rebuild the enchantment cache, causing errors if
     // we have invalid mutations.
@@ -3811,12 +3812,8 @@ void Creature::load( const JsonObject &jsin )
 
     jsin.read( "values", values );
     // potentially migrate some values
-    for( std::pair<std::string, std::string> migration : get_globals().migrations ) {
-        if( values.count( migration.first ) != 0 ) {
-            auto extracted = values.extract( migration.first );
-            extracted.key() = migration.second;
-            values.insert( std::move( extracted ) );
-        }
+    for( const std::pair<const std::string, std::string> &migration : get_globals().migrations ) {
+        values.rename( migration.first, migration.second );
     }
 
     jsin.read( "damage_over_time_map", damage_over_time_map );
@@ -3914,7 +3911,24 @@ void player_morale::load( const JsonObject &jsin )
     jsin.read( "morale", points );
 }
 
-void mm_submap::serialize( JsonOut &jsout ) const
+void mm_id_table::serialize( JsonOut &jsout ) const
+{
+    jsout.start_array();
+    for( const uint16_t id : ids ) {
+        jsout.write( memorized_tile::id_str( id ) );
+    }
+    jsout.end_array();
+}
+
+void mm_id_table::deserialize( const JsonArray &ja )
+{
+    ids.clear();
+    for( const std::string id : ja ) {
+        ids.push_back( memorized_tile::intern_id( id ) );
+    }
+}
+
+void mm_submap::serialize( JsonOut &jsout, mm_id_table &table ) const
 {
     jsout.start_array();
 
@@ -3926,14 +3940,14 @@ void mm_submap::serialize( JsonOut &jsout ) const
     const auto write_seq = [&]() {
         jsout.start_array();
         jsout.write( num_same );
-        jsout.write( last.symbol );
-        jsout.write( last.ter_id );
+        jsout.write( last.get_symbol() );
+        jsout.write( table.local( last.ter_id ) );
         jsout.write( static_cast<int>( last.ter_subtile ) );
-        jsout.write( static_cast<int>( last.ter_rotation ) );
-        if( !last.get_dec_id().empty() ) {
-            jsout.write( last.dec_id );
+        jsout.write( last.get_ter_rotation() );
+        if( last.dec_id != 0 ) {
+            jsout.write( table.local( last.dec_id ) );
             jsout.write( static_cast<int>( last.dec_subtile ) );
-            jsout.write( static_cast<int>( last.dec_rotation ) );
+            jsout.write( last.get_dec_rotation() );
         }
         jsout.end_array();
     };
@@ -3959,7 +3973,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
     jsout.end_array();
 }
 
-void mm_submap::deserialize( int version, const JsonArray &ja )
+void mm_submap::deserialize( int version, const JsonArray &ja, const mm_id_table &table )
 {
     size_t submap_array_idx = 0;
 
@@ -3967,6 +3981,14 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
     memorized_tile tile;
     size_t remaining = 0;
 
+    const auto get_id = [&table]( const JsonArray & ja_tile, int idx ) {
+        const int local = ja_tile.get_int( idx );
+        if( local < 0 || static_cast<size_t>( local ) >= table.ids.size() ) {
+            ja_tile.throw_error( idx, "tile id out of range of the region id table" );
+        }
+        return table.ids[local];
+    };
+
     for( size_t y = 0; y < SEEY; y++ ) {
         for( size_t x = 0; x < SEEX; x++ ) {
             if( remaining > 0 ) {
@@ -3976,7 +3998,7 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
                 if( version < 1 ) { // legacy, remove after 0.H comes out
                     std::string id = ja_tile.get_string( 0 );
                     if( string_starts_with( id, "t_" ) ) {
-                        tile.set_ter_id( std::move( id ) );
+                        tile.set_ter_id( id );
                         tile.set_ter_subtile( ja_tile.get_int( 1 ) );
                         tile.set_ter_rotation( ja_tile.get_int( 2 ) );
                         tile.set_dec_id( "" );
@@ -3986,10 +4008,10 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
                         tile.set_ter_id( "" );
                         tile.set_ter_subtile( 0 );
                         tile.set_ter_rotation( 0 );
-                        tile.set_dec_id( std::move( id ) );
+                        tile.set_dec_id( id );
                         tile.set_dec_subtile( ja_tile.get_int( 1 ) );
                         const int legacy_rotation = ja_tile.get_int( 2 );
-                        if( string_starts_with( tile.dec_id, "vp_" ) ) {
+                        if( string_starts_with( id, "vp_" ) ) {
                             // legacy vehicle rotation needs to be converted from 0-360 degrees
                             // to 0-3 tileset rotation
                             const units::angle legacy_angle = units::from_degrees( legacy_rotation );
@@ -3998,24 +4020,32 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
                             tile.set_dec_rotation( legacy_rotation );
                         }
                     }
-                    tile.symbol = ja_tile.get_int( 3 );
+                    tile.set_symbol( ja_tile.get_int( 3 ) );
                     if( ja_tile.size() > 4 ) {
                         remaining = ja_tile.get_int( 4 ) - 1;
                     }
                 } else {
                     remaining = ja_tile.get_int( 0 ) - 1;
-                    tile.symbol = ja_tile.get_int( 1 );
-                    tile.set_ter_id( ja_tile.get_string( 2 ) );
-                    tile.ter_subtile = ja_tile.get_int( 3 );
-                    tile.ter_rotation = ja_tile.get_int( 4 );
+                    tile.set_symbol( ja_tile.get_int( 1 ) );
+                    if( version < 2 ) {
+                        tile.set_ter_id( ja_tile.get_string( 2 ) );
+                    } else {
+                        tile.ter_id = get_id( ja_tile, 2 );
+                    }
+                    tile.set_ter_subtile( ja_tile.get_int( 3 ) );
+                    tile.set_ter_rotation( ja_tile.get_int( 4 ) );
                     if( ja_tile.size() > 5 ) {
-                        tile.set_dec_id( ja_tile.get_string( 5 ) );
-                        tile.dec_subtile = ja_tile.get_int( 6 );
-                        tile.dec_rotation = ja_tile.get_int( 7 );
+                        if( version < 2 ) {
+                            tile.set_dec_id( ja_tile.get_string( 5 ) );
+                        } else {
+                            tile.dec_id = get_id( ja_tile, 5 );
+                        }
+                        tile.set_dec_subtile( ja_tile.get_int( 6 ) );
+                        tile.set_dec_rotation( ja_tile.get_int( 7 ) );
                     } else {
-                        tile.set_dec_id( "" );
-                        tile.dec_subtile = 0;
-                        tile.dec_rotation = 0;
+                        tile.dec_id = 0;
+                        tile.set_dec_subtile( 0 );
+                        tile.set_dec_rotation( 0 );
                     }
                 }
             }
@@ -4029,8 +4059,11 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
 
 void mm_region::serialize( JsonOut &jsout ) const
 {
+    // Tile ids are written once per region, in a table after the tiles that refer to them.
+    mm_id_table table;
+    table.local( 0 );
     jsout.start_object();
-    jsout.member( "version", 1 );
+    jsout.member( "version", 2 );
     jsout.write( "data" );
     jsout.write_member_separator();
     jsout.start_array();
@@ -4041,11 +4074,12 @@ void mm_region::serialize( JsonOut &jsout ) const
             if( sm->is_empty() ) {
                 jsout.write_null();
             } else {
-                sm->serialize( jsout );
+                sm->serialize( jsout, table );
             }
         }
     }
     jsout.end_array();
+    jsout.member( "ids", table );
     jsout.end_object();
 }
 
@@ -4053,6 +4087,7 @@ void mm_region::deserialize( const JsonValue &ja )
 {
     int version;
     JsonArray region_json;
+    mm_id_table table;
 
     if( ja.test_array() ) { // legacy, remove after 0.H comes out
         version = 0;
@@ -4061,6 +4096,9 @@ void mm_region::deserialize( const JsonValue &ja )
         JsonObject region_obj = ja;
         version = region_obj.get_int( "version" );
         region_json = region_obj.get_array( "data" );
+        if( version >= 2 ) {
+            table.deserialize( region_obj.get_array( "ids" ) );
+        }
     }
 
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
@@ -4070,7 +4108,7 @@ void mm_region::deserialize( const JsonValue &ja )
             sm = make_shared_fast<mm_submap>();
             const JsonValue jsin = region_json.next_value();
             if( !jsin.test_null() ) {
-                sm->deserialize( version, jsin );
+                sm->deserialize( version, jsin, table );
             }
         }
     }
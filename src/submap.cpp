@@ -31,6 +31,14 @@ submap::~submap() = default;
 
 submap &submap::operator=( submap && ) noexcept = default;
 
+bool submap::modified_since_save() const
+{
+    // Vehicles, active items, camps, fields and constructions in progress change without going
+    // through the accessors, so submaps holding any of them are always written
+    return generation != saved_generation || !vehicles.empty() || !active_items.empty() ||
+           camp != nullptr || field_count > 0 || !partial_constructions.empty();
+}
+
 void submap::clear_fields( const point &p )
 {
     field &f = get_field( p );
@@ -81,6 +89,7 @@ const std::string &submap::get_graffiti( const point &p ) const
 
 void submap::set_graffiti( const point &p, const std::string &new_graffiti )
 {
+    mark_modified();
     ensure_nonuniform();
     // Find signage at p if available
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
@@ -93,6 +102,7 @@ void submap::set_graffiti( const point &p, const std::string &new_graffiti )
 
 void submap::delete_graffiti( const point &p )
 {
+    mark_modified();
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
         ensure_nonuniform();
@@ -121,6 +131,7 @@ std::string submap::get_signage( const point &p ) const
 }
 void submap::set_signage( const point &p, const std::string &s )
 {
+    mark_modified();
     ensure_nonuniform();
     // Find signage at p if available
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
@@ -132,6 +143,7 @@ void submap::set_signage( const point &p, const std::string &s )
 }
 void submap::delete_signage( const point &p )
 {
+    mark_modified();
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
         ensure_nonuniform();
@@ -158,6 +170,7 @@ const computer *submap::get_computer( const point &p ) const
 
 computer *submap::get_computer( const point &p )
 {
+    mark_modified();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         return &it->second;
@@ -167,6 +180,7 @@ computer *submap::get_computer( const point &p )
 
 void submap::set_computer( const point &p, const computer &c )
 {
+    mark_modified();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         it->second = c;
@@ -177,6 +191,7 @@ void submap::set_computer( const point &p, const computer &c )
 
 void submap::delete_computer( const point &p )
 {
+    mark_modified();
     computers.erase( p );
 }
 
@@ -198,6 +213,7 @@ bool submap::is_open_air( const point &p ) const
 
 void submap::rotate( int turns )
 {
+    mark_modified();
     if( is_uniform() ) {
         return;
     }
@@ -275,6 +291,7 @@ void submap::rotate( int turns )
 
 void submap::mirror( bool horizontally )
 {
+    mark_modified();
     if( is_uniform() ) {
         return;
     }
@@ -319,6 +336,7 @@ void submap::mirror( bool horizontally )
 
 void submap::revert_submap( submap &sr )
 {
+    mark_modified();
     reverted = true;
     if( sr.is_uniform() ) {
         m.reset();
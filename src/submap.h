@@ -98,11 +98,13 @@ class submap
         }
 
         void set_trap( const point &p, trap_id trap ) {
+            mark_modified();
             ensure_nonuniform();
             m->trp[p.x][p.y] = trap;
         }
 
         void set_all_traps( const trap_id &trap ) {
+            mark_modified();
             ensure_nonuniform();
             std::uninitialized_fill_n( &m->trp[0][0], elements, trap );
         }
@@ -115,11 +117,13 @@ class submap
         }
 
         void set_furn( const point &p, furn_id furn ) {
+            mark_modified();
             ensure_nonuniform();
             m->frn[p.x][p.y] = furn;
         }
 
         void set_all_furn( const furn_id &furn ) {
+            mark_modified();
             ensure_nonuniform();
             std::uninitialized_fill_n( &m->frn[0][0], elements, furn );
         }
@@ -143,11 +147,13 @@ class submap
         }
 
         void set_ter( const point &p, ter_id terr ) {
+            mark_modified();
             ensure_nonuniform();
             m->ter[p.x][p.y] = terr;
         }
 
         void set_all_ter( const ter_id &terr, bool uniform_ok = false ) {
+            mark_modified();
             if( !uniform_ok ) {
                 ensure_nonuniform();
             }
@@ -166,6 +172,7 @@ class submap
         }
 
         void set_radiation( const point &p, const int radiation ) {
+            mark_modified();
             ensure_nonuniform();
             m->rad[p.x][p.y] = radiation;
         }
@@ -193,6 +200,8 @@ class submap
 
         // TODO: Replace this as it essentially makes itm public
         cata::colony<item> &get_items( const point &p ) {
+            // Callers may change the items through the reference
+            mark_modified();
             if( is_uniform() ) {
                 cata::colony<item> static noitems;
                 return noitems;
@@ -210,6 +219,7 @@ class submap
 
         // TODO: Replace this as it essentially makes fld public
         field &get_field( const point &p ) {
+            mark_modified();
             if( is_uniform() ) {
                 field static nofield;
                 return nofield;
@@ -241,6 +251,7 @@ class submap
             ins.str = str;
 
             cosmetics.push_back( ins );
+            mark_modified();
         }
 
         units::temperature_delta get_temperature_mod() const {
@@ -248,6 +259,7 @@ class submap
         }
 
         void set_temperature_mod( units::temperature_delta new_temperature_mod ) {
+            mark_modified();
             temperature_mod = units::to_fahrenheit_delta( new_temperature_mod );
         }
 
@@ -283,6 +295,21 @@ class submap
         void store( JsonOut &jsout ) const;
         void load( const JsonValue &jv, const std::string &member_name, int version );
 
+        /**
+         * Save tracking: mutating accessors bump a generation counter and the mapbuffer skips
+         * writing quads whose submaps are unchanged since they were last written or loaded.
+         * Code that changes the public members directly has to call this itself.
+         */
+        void mark_modified() {
+            ++generation;
+        }
+        /** Whether the submap may differ from its last saved state */
+        bool modified_since_save() const;
+        /** Call after the submap was written to or read from disk */
+        void mark_saved() {
+            saved_generation = generation;
+        }
+
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform() const {
@@ -316,6 +343,9 @@ class submap
         std::unique_ptr<maptile_soa> m;
         ter_id uniform_ter = t_null;
         int temperature_mod = 0; // delta in F
+        // A freshly generated submap has never been saved
+        int generation = 1; // NOLINT(cata-serialize)
+        int saved_generation = 0; // NOLINT(cata-serialize)
 
         static constexpr size_t elements = SEEX * SEEY;
 };
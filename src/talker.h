@@ -9,6 +9,7 @@
 #include "type_id.h"
 #include "units.h"
 #include "units_fwd.h"
+#include "var_store.h"
 #include <list>
 
 class computer;
@@ -358,7 +359,15 @@ class talker
         virtual std::optional<std::string> maybe_get_value( const std::string & ) const {
             return std::nullopt;
         }
+        // Numeric variables for talkers that keep them typed, std::nullopt means the value
+        // (if any) has to be read as text with maybe_get_value
+        virtual std::optional<double> maybe_get_number_value( const std::string & ) const {
+            return std::nullopt;
+        }
         virtual void set_value( const std::string &, const std::string & ) {}
+        virtual void set_number_value( const std::string &key, double value ) {
+            set_value( key, var_value( value ).str() );
+        }
         virtual void remove_value( const std::string & ) {}
 
         // inventory, buying, and selling
@@ -478,11 +478,22 @@ const
     return me_chr_const->maybe_get_value( var_name );
 }
 
+std::optional<double> talker_character_const::maybe_get_number_value(
+    const std::string &var_name ) const
+{
+    return me_chr_const->maybe_get_number_value( var_name );
+}
+
 void talker_character::set_value( const std::string &var_name, const std::string &value )
 {
     me_chr->set_value( var_name, value );
 }
 
+void talker_character::set_number_value( const std::string &var_name, double value )
+{
+    me_chr->set_number_value( var_name, value );
+}
+
 void talker_character::remove_value( const std::string &var_name )
 {
     me_chr->remove_value( var_name );
@@ -0,0 +1,107 @@
+#include "var_store.h"
+
+#include <utility>
+
+#include "cata_utility.h"
+#include "flexbuffer_json-inl.h"
+#include "flexbuffer_json.h"
+#include "json.h"
+#include "string_formatter.h"
+
+var_value::var_value( std::string text ) : text( std::move( text ) ) {}
+
+var_value::var_value( double number ) : num( number ), text_valid( false ), num_valid( true ) {}
+
+const std::string &var_value::str() const
+{
+    if( !text_valid ) {
+        // NOLINTNEXTLINE(cata-translate-string-literal)
+        text = string_format( "%g", *num );
+        text_valid = true;
+    }
+    return text;
+}
+
+std::optional<double> var_value::number() const
+{
+    if( !num_valid ) {
+        num = svtod( text );
+        num_valid = true;
+    }
+    return num;
+}
+
+void var_store::set( const std::string &key, const std::string &value )
+{
+    values[key] = var_value( value );
+}
+
+void var_store::set( const std::string &key, double value )
+{
+    values[key] = var_value( value );
+}
+
+void var_store::remove( const std::string &key )
+{
+    values.erase( key );
+}
+
+void var_store::clear()
+{
+    values.clear();
+}
+
+void var_store::rename( const std::string &from, const std::string &to )
+{
+    auto extracted = values.extract( from );
+    if( extracted ) {
+        extracted.key() = to;
+        values.insert( std::move( extracted ) );
+    }
+}
+
+std::optional<std::string> var_store::maybe_get( const std::string &key ) const
+{
+    auto it = values.find( key );
+    return it == values.end() ? std::nullopt : std::optional<std::string> { it->second.str() };
+}
+
+std::optional<double> var_store::maybe_get_number( const std::string &key ) const
+{
+    auto it = values.find( key );
+    return it == values.end() ? std::nullopt : it->second.number();
+}
+
+std::unordered_map<std::string, std::string> var_store::to_strings() const
+{
+    std::unordered_map<std::string, std::string> ret;
+    for( const std::pair<const std::string, var_value> &v : values ) {
+        ret.emplace( v.first, v.second.str() );
+    }
+    return ret;
+}
+
+void var_store::from_strings( const std::unordered_map<std::string, std::string> &strings )
+{
+    values.clear();
+    for( const std::pair<const std::string, std::string> &v : strings ) {
+        values.emplace( v.first, var_value( v.second ) );
+    }
+}
+
+void var_store::serialize( JsonOut &jsout ) const
+{
+    jsout.start_object();
+    for( const std::pair<const std::string, var_value> &v : values ) {
+        jsout.member( v.first, v.second.str() );
+    }
+    jsout.end_object();
+}
+
+void var_store::deserialize( const JsonObject &jo )
+{
+    values.clear();
+    for( const JsonMember member : jo ) {
+        values.emplace( member.name(), var_value( member.get_string() ) );
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef CATA_SRC_VAR_STORE_H
+#define CATA_SRC_VAR_STORE_H
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+class JsonObject;
+class JsonOut;
+
+/**
+ * Value of a dialogue variable. Numbers written by EOCs and math expressions are kept as
+ * numbers, text is only produced when somebody asks for it (and parsed back at most once).
+ */
+class var_value
+{
+    public:
+        var_value() = default;
+        explicit var_value( std::string text );
+        explicit var_value( double number );
+
+        /** The value as text, numbers are formatted as "%g" like they have always been */
+        const std::string &str() const;
+        /** The value as a number, std::nullopt if it is text that isn't one */
+        std::optional<double> number() const;
+
+    private:
+        mutable std::string text;
+        mutable std::optional<double> num;
+        mutable bool text_valid = true;
+        mutable bool num_valid = false;
+};
+
+/**
+ * Variables of a creature or of the world, by name. Saved as an object of strings, which is
+ * the format the variables have always been saved in.
+ */
+class var_store
+{
+    public:
+        using container = std::unordered_map<std::string, var_value>;
+
+        void set( const std::string &key, const std::string &value );
+        void set( const std::string &key, double value );
+        void remove( const std::string &key );
+        void clear();
+        /** Moves the value of @p from to @p to, used for variable migrations */
+        void rename( const std::string &from, const std::string &to );
+
+        std::optional<std::string> maybe_get( const std::string &key ) const;
+        /** Value of a numeric variable, std::nullopt if unset or not a number */
+        std::optional<double> maybe_get_number( const std::string &key ) const;
+
+        std::unordered_map<std::string, std::string> to_strings() const;
+        void from_strings( const std::unordered_map<std::string, std::string> &strings );
+
+        container::const_iterator begin() const {
+            return values.begin();
+        }
+        container::const_iterator end() const {
+            return values.end();
+        }
+        bool empty() const {
+            return values.empty();
+        }
+
+        void serialize( JsonOut &jsout ) const;
+        void deserialize( const JsonObject &jo );
+
+    private:
+        container values;
+};
+
+#endif // CATA_SRC_VAR_STORE_H
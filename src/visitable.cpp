@@ -149,22 +149,36 @@ bool read_only_visitable::has_quality( const quality_id &qual, int level, int qt
     return has_quality_internal( *this, qual, level, qty ) == qty;
 }
 
+const std::map<int, int> &inventory::quality_levels_of( const quality_id &qual ) const
+{
+    const auto found = quality_levels.find( qual );
+    if( found != quality_levels.end() ) {
+        return found->second;
+    }
+    std::map<int, int> &levels = quality_levels[qual];
+    for( const std::list<item> &stack : items ) {
+        const int stack_size = stack.size();
+        stack.front().visit_items( [&qual, &levels, stack_size]( item * e, item * ) {
+            int &count = levels[e->get_quality( qual )];
+            count = sum_no_wrap( count, stack_size * static_cast<int>( e->count() ) );
+            return VisitResponse::NEXT;
+        } );
+    }
+    return levels;
+}
+
 /** @relates visitable */
 bool inventory::has_quality( const quality_id &qual, int level, int qty ) const
 {
-    const quality_query query{ qual, level, qty };
-
-    if( qualities_cache.find( query ) == qualities_cache.end() ) {
-        int res = 0;
-        for( const auto &stack : this->items ) {
-            res += stack.size() * has_quality_internal( stack.front(), qual, level, qty );
-            if( res >= qty ) {
-                qualities_cache[query] = true;
-            }
+    const std::map<int, int> &levels = quality_levels_of( qual );
+    int res = 0;
+    for( auto it = levels.lower_bound( level ); it != levels.end(); ++it ) {
+        res = sum_no_wrap( res, it->second );
+        if( res >= qty ) {
+            return true;
         }
     }
-
-    return qualities_cache[query];
+    return res >= qty;
 }
 
 /** @relates visitable */
@@ -264,6 +278,13 @@ int read_only_visitable::max_quality( const quality_id &qual ) const
     return max_quality_internal( *this, qual );
 }
 
+/** @relates visitable */
+int inventory::max_quality( const quality_id &qual ) const
+{
+    const std::map<int, int> &levels = quality_levels_of( qual );
+    return levels.empty() ? INT_MIN : levels.rbegin()->first;
+}
+
 /** @relates visitable */
 int Character::max_quality( const quality_id &qual ) const
 {
@@ -616,6 +637,7 @@ std::list<item> inventory::remove_items_with( const
 
     // Invalidate binning cache
     binned = false;
+    quality_levels.clear();
 
     return res;
 }
@@ -905,10 +927,12 @@ int inventory::charges_of( const itype_id &what, int limit,
                            const std::function<void( int )> &visitor, bool in_tools ) const
 {
     const itype_bin &binned = get_binned_items();
-    const auto iter = std::find_if( binned.begin(),
-    binned.end(), [&what]( itype_bin::value_type const & it ) {
-        return it.first == what || ( what == itype_UPS && it.first->has_flag( flag_IS_UPS ) );
-    } );
+    auto iter = binned.find( what );
+    if( iter == binned.end() && what == itype_UPS ) {
+        iter = std::find_if( binned.begin(), binned.end(), []( itype_bin::value_type const & it ) {
+            return it.first->has_flag( flag_IS_UPS );
+        } );
+    }
     if( iter == binned.end() ) {
         return 0;
     }
@@ -0,0 +1,354 @@
+#include "world_backup.h"
+
+#include <zconf.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "cata_path.h"
+#include "cata_utility.h"
+#include "flexbuffer_json-inl.h"
+#include "flexbuffer_json.h"
+#include "gzip_ostream.h"
+#include "json.h"
+#include "ofstream_wrapper.h"
+#include "string_formatter.h"
+#include "zlib.h"
+
+namespace
+{
+
+// Version of the manifest format, bump when changing it.
+constexpr int manifest_version = 1;
+// Blobs are written once and read rarely, so they may as well be small.
+constexpr int blob_compression_level = 6;
+
+struct file_entry {
+    /** Relative to the world directory, with forward slashes */
+    std::string path;
+    std::string blob;
+    int64_t size = 0;
+    int64_t mtime = 0;
+};
+
+fs::path snapshots_dir( const fs::path &store )
+{
+    return store / "snapshots";
+}
+
+fs::path blob_path( const fs::path &store, const std::string &blob )
+{
+    return store / "blobs" / blob.substr( 0, 2 ) / ( blob + ".gz" );
+}
+
+fs::path manifest_path( const fs::path &store, const std::string &snapshot )
+{
+    return snapshots_dir( store ) / ( snapshot + ".json" );
+}
+
+std::string read_raw( const fs::path &path )
+{
+    std::ifstream fin( path, std::ios::binary );
+    if( !fin ) {
+        throw std::runtime_error( "opening " + path.generic_u8string() + " failed" );
+    }
+    std::string contents( ( std::istreambuf_iterator<char>( fin ) ),
+                          std::istreambuf_iterator<char>() );
+    if( fin.bad() ) {
+        throw std::runtime_error( "reading " + path.generic_u8string() + " failed" );
+    }
+    return contents;
+}
+
+/**
+ * Name of the blob holding @p contents: 64 bit FNV-1a followed by the CRC-32 of it, so two
+ * different files would have to collide in both to be mixed up.
+ */
+std::string blob_name( const std::string &contents )
+{
+    uint64_t fnv = 14695981039346656037ULL;
+    for( const char c : contents ) {
+        fnv = ( fnv ^ static_cast<unsigned char>( c ) ) * 1099511628211ULL;
+    }
+    const uLong crc = crc32( crc32( 0L, nullptr, 0 ),
+                             reinterpret_cast<const Bytef *>( contents.data() ),
+                             static_cast<uInt>( contents.size() ) );
+    return string_format( "%016llx%08lx", static_cast<unsigned long long>( fnv ),
+                          static_cast<unsigned long>( crc ) );
+}
+
+int64_t mtime_of( const fs::path &path )
+{
+    std::error_code ec;
+    const fs::file_time_type mtime = fs::last_write_time( path, ec );
+    return ec ? 0 : static_cast<int64_t>( mtime.time_since_epoch().count() );
+}
+
+/**
+ * Calls @p job with every index below @p count, spread over as many threads as the hardware
+ * has. The first exception thrown by a job stops the remaining ones and is rethrown here.
+ */
+void run_in_parallel( size_t count, const std::function<void( size_t )> &job )
+{
+    std::atomic<size_t> next{ 0 };
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+    const auto work = [&]() {
+        for( size_t i = next++; i < count; i = next++ ) {
+            try {
+                job( i );
+            } catch( ... ) {
+                std::lock_guard<std::mutex> lock( failure_mutex );
+                if( !failure ) {
+                    failure = std::current_exception();
+                }
+                next = count;
+            }
+        }
+    };
+    const size_t num_threads = std::min<size_t>( count, std::max( 1U,
+                               std::thread::hardware_concurrency() ) );
+    std::vector<std::thread> threads;
+    for( size_t i = 1; i < num_threads; ++i ) {
+        try {
+            threads.emplace_back( work );
+        } catch( const std::system_error & ) {
+            // Fewer threads then, the calling one works too.
+            break;
+        }
+    }
+    work();
+    for( std::thread &t : threads ) {
+        t.join();
+    }
+    if( failure ) {
+        std::rethrow_exception( failure );
+    }
+}
+
+void write_manifest( const fs::path &path, const std::string &world,
+                     const std::vector<file_entry> &files )
+{
+    write_to_file( cata_path( cata_path::root_path::unknown, path ), [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        jsout.member( "version", manifest_version );
+        jsout.member( "world", world );
+        jsout.member( "files" );
+        jsout.start_array();
+        for( const file_entry &f : files ) {
+            jsout.start_object();
+            jsout.member( "path", f.path );
+            jsout.member( "blob", f.blob );
+            jsout.member( "size", f.size );
+            jsout.member( "mtime", f.mtime );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.end_object();
+    } );
+}
+
+std::optional<std::vector<file_entry>> read_manifest( const fs::path &path )
+{
+    std::optional<std::vector<file_entry>> files;
+    read_from_file_json( cata_path( cata_path::root_path::unknown, path ),
+    [&files]( const JsonValue & jsin ) {
+        JsonObject jo = jsin.get_object();
+        jo.allow_omitted_members();
+        if( jo.get_int( "version" ) > manifest_version ) {
+            jo.throw_error_at( "version", "Backup made by a newer version of the game" );
+        }
+        files.emplace();
+        for( JsonObject jf : jo.get_array( "files" ) ) {
+            file_entry f;
+            f.path = jf.get_string( "path" );
+            f.blob = jf.get_string( "blob" );
+            f.size = jf.get_member( "size" ).get_int64();
+            f.mtime = jf.get_member( "mtime" ).get_int64();
+            files->push_back( std::move( f ) );
+        }
+    } );
+    return files;
+}
+
+std::string new_snapshot_name( const fs::path &store )
+{
+    const std::time_t now =
+        std::chrono::system_clock::to_time_t( std::chrono::system_clock::now() );
+    std::array<char, 32> buf;
+    std::strftime( buf.data(), buf.size(), "%Y%m%d-%H%M%S", std::localtime( &now ) );
+    std::string name = buf.data();
+    // Two snapshots in the same second.
+    for( int i = 2; fs::exists( manifest_path( store, name ) ); ++i ) {
+        name = string_format( "%s-%d", buf.data(), i );
+    }
+    return name;
+}
+
+} // namespace
+
+namespace world_backup
+{
+
+fs::path store_for( const fs::path &world_dir )
+{
+    fs::path dir = world_dir;
+    if( !dir.has_filename() ) {
+        // Trailing separator.
+        dir = dir.parent_path();
+    }
+    return dir.parent_path() / ( dir.filename().u8string() + ".backup" );
+}
+
+std::vector<std::string> snapshots( const fs::path &store )
+{
+    std::vector<std::string> names;
+    std::error_code ec;
+    for( const fs::directory_entry &entry : fs::directory_iterator( snapshots_dir( store ), ec ) ) {
+        if( entry.path().extension() == fs::u8path( ".json" ) ) {
+            names.push_back( entry.path().stem().u8string() );
+        }
+    }
+    // The names start with the time they were taken.
+    std::sort( names.begin(), names.end() );
+    return names;
+}
+
+std::optional<std::string> create( const fs::path &world_dir, const fs::path &store,
+                                   std::string &error )
+{
+    try {
+        // What the last snapshot knew, to skip reading files that haven't changed since.
+        std::unordered_map<std::string, file_entry> previous;
+        const std::vector<std::string> existing = snapshots( store );
+        if( !existing.empty() ) {
+            if( std::optional<std::vector<file_entry>> files = read_manifest( manifest_path( store,
+                    existing.back() ) ) ) {
+                for( file_entry &f : *files ) {
+                    std::string path = f.path;
+                    previous.emplace( std::move( path ), std::move( f ) );
+                }
+            }
+        }
+
+        std::vector<file_entry> files;
+        std::vector<size_t> to_hash;
+        for( const fs::directory_entry &entry : fs::recursive_directory_iterator( world_dir ) ) {
+            // Leftovers of an interrupted write, see ofstream_wrapper.
+            if( !entry.is_regular_file() || entry.path().extension() == fs::u8path( ".temp" ) ) {
+                continue;
+            }
+            file_entry f;
+            f.path = entry.path().lexically_relative( world_dir ).generic_u8string();
+            // Flexbuffers the game keeps of the save files, rebuilt as needed (see json_loader).
+            if( f.path.rfind( "cache/", 0 ) == 0 ) {
+                continue;
+            }
+            f.size = static_cast<int64_t>( entry.file_size() );
+            f.mtime = mtime_of( entry.path() );
+            const auto it = previous.find( f.path );
+            if( it != previous.end() && it->second.size == f.size && it->second.mtime == f.mtime &&
+                fs::exists( blob_path( store, it->second.blob ) ) ) {
+                f.blob = it->second.blob;
+            } else {
+                to_hash.push_back( files.size() );
+            }
+            files.push_back( std::move( f ) );
+        }
+
+        // Blobs some thread is writing already, in case two files have the same contents.
+        std::unordered_set<std::string> claimed;
+        std::mutex claimed_mutex;
+        run_in_parallel( to_hash.size(), [&]( size_t i ) {
+            file_entry &f = files[to_hash[i]];
+            const std::string contents = read_raw( world_dir / fs::u8path( f.path ) );
+            f.size = static_cast<int64_t>( contents.size() );
+            f.blob = blob_name( contents );
+            {
+                std::lock_guard<std::mutex> lock( claimed_mutex );
+                if( !claimed.insert( f.blob ).second ) {
+                    return;
+                }
+            }
+            const fs::path blob = blob_path( store, f.blob );
+            if( fs::exists( blob ) ) {
+                return;
+            }
+            fs::create_directories( blob.parent_path() );
+            ofstream_wrapper fout( blob, std::ios::binary );
+            gzip_ostream zout( fout.stream(), blob_compression_level );
+            zout.write( contents.data(), contents.size() );
+            zout.finish();
+            fout.close();
+        } );
+
+        std::sort( files.begin(), files.end(), []( const file_entry & a, const file_entry & b ) {
+            return a.path < b.path;
+        } );
+        assure_dir_exist( snapshots_dir( store ) );
+        const std::string name = new_snapshot_name( store );
+        write_manifest( manifest_path( store, name ), world_dir.filename().u8string(), files );
+        return name;
+    } catch( const std::exception &err ) {
+        error = err.what();
+        return std::nullopt;
+    }
+}
+
+bool restore( const fs::path &store, const std::string &snapshot, const fs::path &target_dir,
+              std::string &error )
+{
+    try {
+        if( fs::exists( target_dir ) ) {
+            throw std::runtime_error( target_dir.generic_u8string() + " already exists" );
+        }
+        const std::optional<std::vector<file_entry>> files =
+            read_manifest( manifest_path( store, snapshot ) );
+        if( !files ) {
+            throw std::runtime_error( "reading snapshot " + snapshot + " failed" );
+        }
+        run_in_parallel( files->size(), [&]( size_t i ) {
+            const file_entry &f = ( *files )[i];
+            const fs::path path = target_dir / fs::u8path( f.path );
+            // Blobs are always gzip, whatever they hold, so this takes off exactly that layer.
+            std::optional<std::string> contents = read_whole_file( blob_path( store, f.blob ) );
+            if( !contents || blob_name( *contents ) != f.blob ) {
+                throw std::runtime_error( "the backup of " + f.path + " is missing or damaged" );
+            }
+            fs::create_directories( path.parent_path() );
+            ofstream_wrapper fout( path, std::ios::binary );
+            fout.stream().write( contents->data(), contents->size() );
+            fout.close();
+        } );
+        return true;
+    } catch( const std::exception &err ) {
+        error = err.what();
+        return false;
+    }
+}
+
+} // namespace world_backup
@@ -0,0 +1,47 @@
+#pragma once
+#ifndef CATA_SRC_WORLD_BACKUP_H
+#define CATA_SRC_WORLD_BACKUP_H
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "filesystem.h"
+
+/**
+ * Incremental backups of a world directory.
+ *
+ * A backup store holds every file content it has seen once, gzip-compressed and named after
+ * a hash of the content ("blobs/ab/ab12....gz"), and one manifest per snapshot
+ * ("snapshots/<time>.json") that lists each file of the world with the blob holding it.
+ * Taking a snapshot only compresses files whose content the store doesn't have yet, and files
+ * that have the same size and modification time as in the previous snapshot aren't even read.
+ * The world's "cache" directory is left out, the game rebuilds it on its own.
+ */
+namespace world_backup
+{
+
+/** The store used for @p world_dir: a "<world>.backup" directory next to it. */
+fs::path store_for( const fs::path &world_dir );
+
+/**
+ * Adds a snapshot of @p world_dir to @p store, compressing new contents on worker threads.
+ * @return The name of the snapshot, std::nullopt (with the reason in @p error) on failure.
+ */
+std::optional<std::string> create( const fs::path &world_dir, const fs::path &store,
+                                   std::string &error );
+
+/** Names of the snapshots in @p store, oldest first. */
+std::vector<std::string> snapshots( const fs::path &store );
+
+/**
+ * Rebuilds the world directory as it was in @p snapshot at @p target_dir, which must not
+ * exist yet.
+ * @return false (with the reason in @p error) on failure.
+ */
+bool restore( const fs::path &store, const std::string &snapshot, const fs::path &target_dir,
+              std::string &error );
+
+} // namespace world_backup
+
+#endif // CATA_SRC_WORLD_BACKUP_H
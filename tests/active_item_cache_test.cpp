@@ -1,7 +1,10 @@
+#include <list>
 #include <set>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "cata_catch.h"
+#include "cata_scope_helpers.h"
 #include "game_constants.h"
 #include "item.h"
 #include "map.h"
@@ -40,3 +43,36 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "active_items_are_visited_once_per_processing_interval", "[item]" )
+{
+    restore_on_out_of_scope<time_point> restore_turn( calendar::turn );
+    calendar::turn = calendar::turn_zero + 1_days;
+
+    std::list<item> items;
+    active_item_cache cache;
+    for( int i = 0; i < 5; ++i ) {
+        item &food = items.emplace_back( "apple", calendar::turn_zero );
+        REQUIRE( food.processing_speed() > 1 );
+        REQUIRE( cache.add( food, point_zero ) );
+    }
+    const int interval = items.front().processing_speed();
+
+    // Everything that was just added is due right away
+    CHECK( cache.get_for_processing().size() == 5 );
+
+    // Then nothing comes up again until a full interval has passed, however few items there are
+    int visits = 0;
+    for( int turn = 1; turn < interval; ++turn ) {
+        calendar::turn += 1_turns;
+        visits += cache.get_for_processing().size();
+    }
+    CHECK( visits == 0 );
+    calendar::turn += 1_turns;
+    CHECK( cache.get_for_processing().size() == 5 );
+
+    // A destroyed item is dropped once it is due
+    items.pop_front();
+    calendar::turn += time_duration::from_turns( interval );
+    CHECK( cache.get_for_processing().size() == 4 );
+}
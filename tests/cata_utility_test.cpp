@@ -1,16 +1,29 @@
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <fstream>
 #include <iosfwd>
+#include <istream>
+#include <iterator>
 #include <map>
+#include <ostream>
 #include <set>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
 #include "assertion_helpers.h"
 #include "cata_utility.h"
 #include "cata_catch.h"
+#include "cata_path.h"
 #include "debug_menu.h"
+#include "deferred_writes.h"
+#include "filesystem.h"
+#include "flexbuffer_json.h"
+#include "json_loader.h"
+#include "options_helpers.h"
+#include "path_info.h"
 #include "units.h"
 #include "units_utility.h"
 
@@ -409,3 +422,144 @@ TEST_CASE( "lcmatch", "[utility][nogame]" )
     CHECK( lcmatch( "無効", "無" ) == true );
     CHECK( lcmatch( "無効", "無效" ) == false );
 }
+
+TEST_CASE( "deferred_writes_are_on_disk_before_they_are_read", "[utility][nogame]" )
+{
+    const std::string path = PATH_INFO::savedir() + "deferred_writes_test.txt";
+    const auto write = [&path]( const std::string & contents ) {
+        write_to_file( path, [&contents]( std::ostream & fout ) {
+            fout << contents;
+        } );
+    };
+    const auto read = [&path]() {
+        std::string contents;
+        read_from_file( path, [&contents]( std::istream & fin ) {
+            std::getline( fin, contents );
+        } );
+        return contents;
+    };
+
+    {
+        deferred_writes::scope deferred;
+        CHECK( deferred_writes::active() );
+        for( int i = 0; i < 10; ++i ) {
+            write( "write " + std::to_string( i ) );
+        }
+    }
+    CHECK_FALSE( deferred_writes::active() );
+    // The last queued write wins and reading waits for it.
+    CHECK( file_exist( path ) );
+    CHECK( read() == "write 9" );
+    CHECK( deferred_writes::finish() );
+
+    write( "direct" );
+    CHECK( read() == "direct" );
+    remove_file( path );
+}
+
+TEST_CASE( "compressed_save_files_read_back_unchanged", "[utility]" )
+{
+    const std::string path = PATH_INFO::savedir() + "compressed_save_test.json";
+    // Larger than the compressor's buffers, so it takes several chunks.
+    std::string contents;
+    for( int i = 0; contents.size() < 300 * 1024; ++i ) {
+        contents += "[ \"t_grass\", " + std::to_string( i % 97 ) + " ],\n";
+    }
+    const auto write = [&]() {
+        write_save_file( path, [&contents]( std::ostream & fout ) {
+            fout << contents;
+        } );
+    };
+    const auto check_read_back = [&]() {
+        std::string read_back;
+        read_from_file( path, [&read_back]( std::istream & fin ) {
+            read_back.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+        } );
+        CHECK( read_back == contents );
+        CHECK( read_whole_file( path ) == contents );
+    };
+    const auto is_gzip = [&path]() {
+        std::ifstream fin( fs::u8path( path ), std::ios::binary );
+        std::array<char, 2> header = {};
+        fin.read( header.data(), header.size() );
+        return header[0] == '\x1f' && header[1] == '\x8b';
+    };
+
+    SECTION( "uncompressed by default" ) {
+        write();
+        CHECK_FALSE( is_gzip() );
+        check_read_back();
+    }
+    SECTION( "compressed when the world asks for it" ) {
+        override_option compression( "SAVE_COMPRESSION", "6" );
+        write();
+        CHECK( is_gzip() );
+        CHECK( fs::file_size( fs::u8path( path ) ) < contents.size() / 4 );
+        check_read_back();
+    }
+    SECTION( "compressed on the writer thread" ) {
+        override_option compression( "SAVE_COMPRESSION", "1" );
+        {
+            deferred_writes::scope deferred;
+            write();
+        }
+        CHECK( deferred_writes::finish() );
+        CHECK( is_gzip() );
+        check_read_back();
+    }
+    remove_file( path );
+}
+
+static size_t count_flexbuffers( const fs::path &dir )
+{
+    size_t count = 0;
+    std::error_code ec;
+    for( const fs::directory_entry &entry : fs::recursive_directory_iterator( dir, ec ) ) {
+        count += entry.path().extension() == fs::u8path( ".fb" );
+    }
+    return count;
+}
+
+TEST_CASE( "save_files_load_from_their_cached_flexbuffer", "[utility]" )
+{
+    const fs::path world = fs::u8path( PATH_INFO::savedir() ) / "flexbuffer_cache_test";
+    fs::remove_all( world );
+    fs::create_directories( world );
+    const cata_path path( cata_path::root_path::save, "flexbuffer_cache_test/o.0.0" );
+    const auto write = [&path]( int value ) {
+        write_save_file( path, [value]( std::ostream & fout ) {
+            fout << "# version 1\n{ \"value\": " << value << " }";
+        } );
+    };
+    const auto load = [&path]() {
+        // Past the version line.
+        return json_loader::from_path_at_offset( path, 12 ).get_object().get_int( "value" );
+    };
+
+    {
+        deferred_writes::scope deferred;
+        write( 1 );
+    }
+    CHECK( deferred_writes::finish() );
+    // Written along with the file.
+    CHECK( count_flexbuffers( world / "cache" ) == 1 );
+    CHECK( load() == 1 );
+
+    // Not deferred, the old flexbuffer goes, even if the file ends up with the same time.
+    write( 2 );
+    CHECK( count_flexbuffers( world / "cache" ) == 0 );
+    CHECK( load() == 2 );
+    // Loading cached it.
+    CHECK( count_flexbuffers( world / "cache" ) == 1 );
+    CHECK( load() == 2 );
+
+    {
+        deferred_writes::scope deferred;
+        write( 3 );
+    }
+    CHECK( deferred_writes::finish() );
+    CHECK( count_flexbuffers( world / "cache" ) == 1 );
+    CHECK( load() == 3 );
+
+    fs::remove_all( world );
+}
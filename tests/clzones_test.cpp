@@ -23,6 +23,7 @@ static const itype_id itype_belt223( "belt223" );
 
 static const vproto_id vehicle_prototype_shopping_cart( "shopping_cart" );
 
+static const zone_type_id zone_type_LOOT_DEFAULT( "LOOT_DEFAULT" );
 static const zone_type_id zone_type_LOOT_DRINK( "LOOT_DRINK" );
 static const zone_type_id zone_type_LOOT_FOOD( "LOOT_FOOD" );
 static const zone_type_id zone_type_LOOT_PDRINK( "LOOT_PDRINK" );
@@ -116,6 +117,40 @@ TEST_CASE( "zone_unloading_ammo_belts", "[zones][items][ammo_belt][activities][u
     }
 }
 
+TEST_CASE( "zone_areas_answer_point_queries", "[zones]" )
+{
+    clear_map();
+    zone_manager &zm = zone_manager::get_manager();
+    const tripoint_abs_ms origin_pos;
+    const tripoint_abs_ms corner( 4, 2, 0 );
+    const tripoint_abs_ms far_corner( 6, 5, 0 );
+    zm.add( "Default", zone_type_LOOT_DEFAULT, faction_your_followers, false, true,
+            far_corner.raw(), corner.raw() );
+
+    CHECK( zm.has( zone_type_LOOT_DEFAULT, tripoint_abs_ms( 5, 3, 0 ), faction_your_followers ) );
+    CHECK_FALSE( zm.has( zone_type_LOOT_DEFAULT, tripoint_abs_ms( 7, 3, 0 ),
+                         faction_your_followers ) );
+    CHECK( zm.has_near( zone_type_LOOT_DEFAULT, origin_pos, 4, faction_your_followers ) );
+    CHECK_FALSE( zm.has_near( zone_type_LOOT_DEFAULT, origin_pos, 3, faction_your_followers ) );
+
+    const std::unordered_set<tripoint_abs_ms> near =
+        zm.get_near( zone_type_LOOT_DEFAULT, origin_pos, 5, nullptr, faction_your_followers );
+    // x in 4..5, y in 2..5
+    CHECK( near.size() == 8 );
+    CHECK( near.count( corner ) == 1 );
+    CHECK( near.count( far_corner ) == 0 );
+    CHECK( zm.get_nearest( zone_type_LOOT_DEFAULT, origin_pos, 60, faction_your_followers ) ==
+           corner );
+
+    item hammer( "hammer" );
+    CHECK( zm.get_near_zone_type_for_item( hammer, origin_pos, 60, faction_your_followers ) ==
+           zone_type_LOOT_DEFAULT );
+    // the cached destination must not outlive the zone
+    clear_map();
+    CHECK_FALSE( zm.get_near_zone_type_for_item( hammer, origin_pos, 60,
+                 faction_your_followers ).is_valid() );
+}
+
 // Comestibles sorting is a bit awkward. Unlike other loot, they're almost
 // always inside of a container, and their sort zone changes based on their
 // shelf life and whether the container prevents rotting.
@@ -207,6 +207,73 @@ TEST_CASE( "recipe_subset" )
     }
 }
 
+TEST_CASE( "recipes_are_indexed_by_the_items_and_qualities_they_use", "[recipes]" )
+{
+    for( const auto &e : recipe_dict ) {
+        const recipe &r = e.second;
+        if( r.obsolete ) {
+            continue;
+        }
+        CAPTURE( r.ident().str() );
+        for( const requirement_data &req : r.deduped_requirements().alternatives() ) {
+            for( const std::vector<item_comp> &comps : req.get_components() ) {
+                for( const item_comp &comp : comps ) {
+                    CHECK( recipe_dict.recipes_using_item( comp.type ).count( &r ) == 1 );
+                }
+            }
+            for( const std::vector<tool_comp> &tools : req.get_tools() ) {
+                for( const tool_comp &tool : tools ) {
+                    CHECK( recipe_dict.recipes_using_item( tool.type ).count( &r ) == 1 );
+                }
+            }
+            for( const std::vector<quality_requirement> &quals : req.get_qualities() ) {
+                for( const quality_requirement &qual : quals ) {
+                    CHECK( recipe_dict.recipes_using_quality( qual.type ).count( &r ) == 1 );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE( "recipes_are_indexed_by_products_skills_and_proficiencies", "[recipes]" )
+{
+    const auto indexed = []( const std::vector<const recipe *> &list, const recipe * r ) {
+        return std::binary_search( list.begin(), list.end(), r );
+    };
+    const std::map<skill_id, std::vector<const recipe *>> &primary =
+                recipe_dict.recipes_by_skill( true );
+    const std::map<skill_id, std::vector<const recipe *>> &any_skill =
+                recipe_dict.recipes_by_skill( false );
+    const std::map<proficiency_id, std::vector<const recipe *>> &profs =
+                recipe_dict.recipes_by_proficiency();
+
+    for( const auto &e : recipe_dict ) {
+        const recipe &r = e.second;
+        if( r.obsolete ) {
+            continue;
+        }
+        CAPTURE( r.ident().str() );
+        CHECK( indexed( recipe_dict.recipes_producing( r.result() ), &r ) );
+        for( const std::pair<const itype_id, int> &bp : r.get_byproducts() ) {
+            CHECK( indexed( recipe_dict.recipes_producing( bp.first ), &r ) );
+        }
+        if( r.skill_used ) {
+            REQUIRE( primary.count( r.skill_used ) == 1 );
+            CHECK( indexed( primary.at( r.skill_used ), &r ) );
+            REQUIRE( any_skill.count( r.skill_used ) == 1 );
+            CHECK( indexed( any_skill.at( r.skill_used ), &r ) );
+        }
+        for( const std::pair<const skill_id, int> &sk : r.required_skills ) {
+            REQUIRE( any_skill.count( sk.first ) == 1 );
+            CHECK( indexed( any_skill.at( sk.first ), &r ) );
+        }
+        for( const proficiency_id &prof : r.used_proficiencies() ) {
+            REQUIRE( profs.count( prof ) == 1 );
+            CHECK( indexed( profs.at( prof ), &r ) );
+        }
+    }
+}
+
 TEST_CASE( "available_recipes", "[recipes]" )
 {
     const recipe *r = &recipe_magazine_battery_light_mod.obj();
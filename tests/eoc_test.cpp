@@ -1328,3 +1328,39 @@ TEST_CASE( "EOC_string_test", "[eoc]" )
     CHECK( get_avatar().get_value( "npctalk_var_key2" ) == "nest3" );
     CHECK( get_avatar().get_value( "npctalk_var_key3" ) == "nest4" );
 }
+
+TEST_CASE( "queued_eocs_are_bucketed_by_due_turn", "[eoc]" )
+{
+    const time_point now = calendar::turn_zero + 1_hours;
+    queued_eocs queue;
+    queue.push( queued_eoc{ effect_on_condition_EOC_alive_test, now + 2_turns, {} } );
+    queue.push( queued_eoc{ effect_on_condition_EOC_map_test, now, {} } );
+    queue.push( queued_eoc{ effect_on_condition_EOC_attack_test, now, {} } );
+    queue.push( queued_eoc{ effect_on_condition_EOC_jmath_test, now - 1_turns, {} } );
+
+    CHECK( queue.top().eoc == effect_on_condition_EOC_jmath_test );
+
+    std::vector<queued_eocs::storage_iter> due = queue.take_due( now );
+    REQUIRE( due.size() == 1 );
+    CHECK( due[0]->eoc == effect_on_condition_EOC_jmath_test );
+    queue.list.erase( due[0] );
+
+    due = queue.take_due( now );
+    REQUIRE( due.size() == 2 );
+    CHECK( due[0]->eoc == effect_on_condition_EOC_map_test );
+    CHECK( due[1]->eoc == effect_on_condition_EOC_attack_test );
+    CHECK( queue.take_due( now ).empty() );
+
+    // Rescheduled entries move to their new bucket, copies rebuild the buckets
+    due[0]->time = now + 2_turns;
+    queue.schedule( due[0] );
+    queue.list.erase( due[1] );
+    queued_eocs copy( queue );
+    CHECK( copy.list.size() == 2 );
+    CHECK( copy.take_due( now + 2_turns ).size() == 2 );
+
+    queue.pop();
+    queue.pop();
+    CHECK( queue.empty() );
+    CHECK( queue.list.empty() );
+}
@@ -1,13 +1,16 @@
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <map>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -17,16 +20,23 @@
 #include "cata_utility.h"
 #include "cata_catch.h"
 #include "colony.h"
+#include "coordinates.h"
 #include "damage.h"
 #include "debug.h"
 #include "enum_bitset.h"
+#include "game_constants.h"
 #include "item.h"
 #include "json.h"
 #include "json_loader.h"
 #include "magic.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
 #include "mutation.h"
+#include "point.h"
 #include "sounds.h"
 #include "string_formatter.h"
+#include "submap.h"
 #include "translations.h"
 #include "type_id.h"
 
@@ -947,3 +957,86 @@ TEST_CASE( "serialize_optional", "[json]" )
         test_serialization( v, "[1,2,3]" );
     }
 }
+
+TEST_CASE( "jsonout_formats_values_like_the_stream_did", "[json]" )
+{
+    std::ostringstream os;
+    {
+        JsonOut jsout( os );
+        jsout.start_array();
+        jsout.write( true );
+        jsout.write( -12 );
+        jsout.write( std::numeric_limits<int64_t>::min() );
+        jsout.write( std::numeric_limits<uint64_t>::max() );
+        jsout.write( 1.5 );
+        jsout.write( 0.1f );
+        jsout.write( 'a' );
+        jsout.write( std::string_view( "q\"b\\s/\n\t\x01\x1f\xc3\xa9" ) );
+        jsout.write_null();
+        jsout.end_array();
+    }
+    CHECK( os.str() == "[true,-12,-9223372036854775808,18446744073709551615,1.500000,0.100000,97,"
+           R"("q\"b\\s/\n\t\u0001\u001Fé",null])" );
+}
+
+TEST_CASE( "jsonout_flushes_before_direct_stream_access", "[json]" )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_object();
+    jsout.member( "a", 1 );
+    // Nothing has to reach the stream in the middle of a value...
+    jsout.get_stream()->put( '\n' );
+    jsout.member( "b", 2 );
+    jsout.end_object();
+    // ...but all of it once the top level value is complete.
+    CHECK( os.str() == "{\"a\":1\n,\"b\":2}" );
+}
+
+TEST_CASE( "jsonout_world_save_benchmark", "[.][json][benchmark]" )
+{
+    // A synthetic world save: every submap of the reality bubble, with items strewn about
+    // and lots of numbers and strings in them.
+    clear_map();
+    map &here = get_map();
+    for( int x = 0; x < MAPSIZE_X; x += 3 ) {
+        for( int y = 0; y < MAPSIZE_Y; y += 3 ) {
+            item rag( itype_test_rag );
+            rag.set_var( "note", "a \"quoted\" note\nover two lines" );
+            rag.set_var( "counter", x * y );
+            here.add_item( tripoint_bub_ms( x, y, 0 ), rag );
+        }
+    }
+    const auto save_world = [&here]( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.start_array();
+        for( int z = -OVERMAP_DEPTH; z <= 0; ++z ) {
+            for( int x = 0; x < MAPSIZE; ++x ) {
+                for( int y = 0; y < MAPSIZE; ++y ) {
+                    const tripoint_abs_sm p = here.get_abs_sub() + tripoint_rel_sm( x, y, z );
+                    const submap *sm = MAPBUFFER.lookup_submap( p );
+                    if( sm == nullptr ) {
+                        continue;
+                    }
+                    jsout.start_object();
+                    jsout.member( "coordinates", p );
+                    sm->store( jsout );
+                    jsout.end_object();
+                }
+            }
+        }
+        jsout.end_array();
+    };
+
+    std::ostringstream os;
+    save_world( os );
+    const std::string saved = os.str();
+    REQUIRE( json_loader::from_string( saved ).test_array() );
+    WARN( string_format( "synthetic world save is %d bytes", saved.size() ) );
+
+    BENCHMARK( "serialize to memory" ) {
+        std::ostringstream out;
+        save_world( out );
+        return out.tellp();
+    };
+}
@@ -1,14 +1,18 @@
 #include <bitset>
 #include <cstdio>
 #include <sstream>
+#include <string>
 #include <type_traits>
 
 #include "cata_catch.h"
 #include "game_constants.h"
 #include "json.h"
+#include "json_loader.h"
 #include "lru_cache.h"
 #include "map.h"
 #include "map_memory.h"
+#include "memory_fast.h"
+#include "output.h"
 #include "point.h"
 
 static constexpr tripoint_abs_ms p1{ -SEEX - 2, -SEEY - 3, -1 };
@@ -38,9 +42,9 @@ TEST_CASE( "map_memory_defaults", "[map_memory]" )
 {
     map_memory memory;
     memory.prepare_region( p1, p2 );
-    CHECK( memory.get_tile( p1 ).symbol == 0 );
+    CHECK( memory.get_tile( p1 ).get_symbol() == 0 );
     memorized_tile default_tile = memory.get_tile( p1 );
-    CHECK( default_tile.symbol == 0 );
+    CHECK( default_tile.get_symbol() == 0 );
     CHECK( default_tile.get_ter_id().empty() );
     CHECK( default_tile.get_ter_subtile() == 0 );
     CHECK( default_tile.get_ter_rotation() == 0 );
@@ -55,8 +59,8 @@ TEST_CASE( "map_memory_remembers", "[map_memory]" )
     memory.prepare_region( p1, p2 );
     memory.set_tile_symbol( p1, 1 );
     memory.set_tile_symbol( p2, 2 );
-    CHECK( memory.get_tile( p1 ).symbol == 1 );
-    CHECK( memory.get_tile( p2 ).symbol == 2 );
+    CHECK( memory.get_tile( p1 ).get_symbol() == 1 );
+    CHECK( memory.get_tile( p2 ).get_symbol() == 2 );
 
     const memorized_tile &mt = memory.get_tile( p2 );
 
@@ -92,8 +96,8 @@ TEST_CASE( "map_memory_overwrites", "[map_memory]" )
     memory.set_tile_symbol( p1, 1 );
     memory.set_tile_symbol( p2, 2 );
     memory.set_tile_symbol( p2, 3 );
-    CHECK( memory.get_tile( p1 ).symbol == 1 );
-    CHECK( memory.get_tile( p2 ).symbol == 3 );
+    CHECK( memory.get_tile( p1 ).get_symbol() == 1 );
+    CHECK( memory.get_tile( p2 ).get_symbol() == 3 );
 }
 
 TEST_CASE( "map_memory_forgets", "[map_memory]" )
@@ -103,7 +107,7 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     memory.set_tile_decoration( p1, "vp_foo", 42, 3 );
     memory.set_tile_terrain( p1, "t_foo", 43, 2 );
     const memorized_tile &mt = memory.get_tile( p1 );
-    CHECK( mt.symbol == 0 );
+    CHECK( mt.get_symbol() == 0 );
     CHECK( mt.get_ter_id() == "t_foo" );
     CHECK( mt.get_ter_subtile() == 43 );
     CHECK( mt.get_ter_rotation() == 2 );
@@ -111,9 +115,9 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     CHECK( mt.get_dec_subtile() == 42 );
     CHECK( mt.get_dec_rotation() == 3 );
     memory.set_tile_symbol( p1, 1 );
-    CHECK( mt.symbol == 1 );
+    CHECK( mt.get_symbol() == 1 );
     memory.clear_tile_decoration( p1, /* prefix = */ "vp_" );
-    CHECK( mt.symbol == 0 );
+    CHECK( mt.get_symbol() == 0 );
     CHECK( mt.get_ter_id() == "t_foo" );
     CHECK( mt.get_ter_subtile() == 43 );
     CHECK( mt.get_ter_rotation() == 2 );
@@ -122,7 +126,71 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     CHECK( mt.get_dec_rotation() == 0 );
 }
 
-// TODO: map memory save / load
+TEST_CASE( "memorized_tile_is_packed", "[map_memory]" )
+{
+    CHECK( sizeof( memorized_tile ) == 8 );
+}
+
+static mm_region round_trip( const std::string &json )
+{
+    mm_region reg;
+    reg.deserialize( json_loader::from_string( json ) );
+    return reg;
+}
+
+TEST_CASE( "map_memory_region_save_load", "[map_memory]" )
+{
+    mm_region reg;
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+            reg.submaps[x][y] = make_shared_fast<mm_submap>();
+        }
+    }
+    memorized_tile wall;
+    wall.set_ter_id( "t_wall" );
+    wall.set_ter_subtile( 2 );
+    wall.set_ter_rotation( 15 );
+    wall.set_symbol( LINE_XOXO );
+    memorized_tile chair = wall;
+    chair.set_ter_id( "t_floor" );
+    chair.set_dec_id( "f_chair" );
+    chair.set_dec_rotation( 3 );
+    for( int x = 0; x < SEEX; x++ ) {
+        reg.submaps[1][0]->set_tile( point_sm_ms( x, 0 ), wall );
+    }
+    reg.submaps[1][0]->set_tile( point_sm_ms( 3, 3 ), chair );
+
+    std::ostringstream os;
+    {
+        JsonOut jsout( os );
+        reg.serialize( jsout );
+    }
+    // Every id is written once, in the table.
+    CHECK( os.str().find( "t_wall" ) == os.str().rfind( "t_wall" ) );
+
+    const mm_region loaded = round_trip( os.str() );
+    CHECK( loaded.submaps[0][0]->is_empty() );
+    CHECK( loaded.submaps[1][0]->get_tile( point_sm_ms( SEEX - 1, 0 ) ) == wall );
+    CHECK( loaded.submaps[1][0]->get_tile( point_sm_ms( 3, 3 ) ) == chair );
+    CHECK( loaded.submaps[1][0]->get_tile( point_sm_ms( 3, 4 ) ) == mm_submap::default_tile );
+
+    SECTION( "regions saved with ids inline still load" ) {
+        std::string legacy = R"({"version":1,"data":[)";
+        for( size_t i = 0; i < MM_REG_SIZE * MM_REG_SIZE; i++ ) {
+            legacy += i == 0 ? "[[1,120,\"t_floor\",0,0,\"f_chair\",0,3],[143,0,\"\",0,0]]" :
+                      ",null";
+        }
+        legacy += "]}";
+        const mm_region legacy_reg = round_trip( legacy );
+        const memorized_tile &mt = legacy_reg.submaps[0][0]->get_tile( point_sm_ms( 0, 0 ) );
+        CHECK( mt.get_symbol() == 'x' );
+        CHECK( mt.get_ter_id() == "t_floor" );
+        CHECK( mt.get_dec_id() == "f_chair" );
+        CHECK( mt.get_dec_rotation() == 3 );
+        CHECK( legacy_reg.submaps[0][0]->get_tile( point_sm_ms( 1, 0 ) ) ==
+               mm_submap::default_tile );
+    }
+}
 
 #include <chrono>
 
@@ -345,3 +345,65 @@ TEST_CASE( "math_parser_dialogue_integration", "[math_parser]" )
         CHECK_FALSE( testexp.parse( "val( 'stamina' ) * 3", true ) ); // eval expression in assignment tree
     } );
 }
+
+TEST_CASE( "math_parser_compiled_matches_tree", "[math_parser]" )
+{
+    standard_npc dude;
+    dialogue d( get_talker_for( get_avatar() ), get_talker_for( &dude ) );
+    math_exp testexp;
+    global_variables &globvars = get_globals();
+    globvars.set_global_value( "npctalk_var_x", "7" );
+    get_avatar().set_value( "npctalk_var_y", "-3" );
+    dude.set_value( "npctalk_var_z", "0.5" );
+
+    std::string const expr = GENERATE( as<std::string>(),
+                                       "1 + 2 * 3",
+                                       "x * 2 + 1",
+                                       "-x ^ 2",
+                                       "(x + u_y) * n_z - 4 / (1 + 1)",
+                                       "max( x, u_y, 3 * 4, -n_z )",
+                                       "x > 5 ? u_y : n_z",
+                                       "1 ? x : u_y",
+                                       "0 ? x : 1 ? u_y : n_z",
+                                       "u_y < 0 ? ( n_z > 0 ? x : 2 ) : 3",
+                                       "clamp( x, 1, 5 ) + floor( n_z ) + sin( pi / 2 )",
+                                       "value_or( _ctx, x + 1 ) * 2",
+                                       "has_var(_ctx) ? 19 : x ? 20 : 21",
+                                       "_test_diag_( x, 'a': u_y * 2 ) + 1",
+                                       "max( 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, x )",
+                                       "1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+x))))))))))))))))))" );
+    CAPTURE( expr );
+    REQUIRE( testexp.parse( expr ) );
+    CHECK( testexp.eval( d ) == Approx( testexp.eval_tree( d ) ) );
+}
+
+TEST_CASE( "math_parser_numeric_variables", "[math_parser]" )
+{
+    standard_npc dude;
+    dialogue d( get_talker_for( get_avatar() ), get_talker_for( &dude ) );
+    math_exp testexp;
+    math_exp assignexp;
+    global_variables &globvars = get_globals();
+
+    std::string const scope = GENERATE( as<std::string>(), "", "u_", "n_" );
+    CAPTURE( scope );
+    REQUIRE( assignexp.parse( scope + "big", true ) );
+    assignexp.assign( d, 1234567 );
+    REQUIRE( testexp.parse( scope + "big" ) );
+    // numbers are read back exactly, their text is the same as it always was
+    CHECK( testexp.eval( d ) == 1234567 );
+    std::string const text = scope.empty() ? globvars.get_global_value( "npctalk_var_big" ) :
+                             scope == "u_" ? get_avatar().get_value( "npctalk_var_big" ) :
+                             dude.get_value( "npctalk_var_big" );
+    CHECK( text == "1.23457e+06" );
+
+    // text that happens to be a number is still a number
+    if( scope.empty() ) {
+        globvars.set_global_value( "npctalk_var_big", "2.5" );
+    } else if( scope == "u_" ) {
+        get_avatar().set_value( "npctalk_var_big", "2.5" );
+    } else {
+        dude.set_value( "npctalk_var_big", "2.5" );
+    }
+    CHECK( testexp.eval( d ) == Approx( 2.5 ) );
+}
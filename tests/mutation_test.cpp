@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <map>
 #include <sstream>
 #include <string>
@@ -762,3 +763,54 @@ TEST_CASE( "Threshold_substitutions", "[mutations]" )
     CHECK( !dummy.has_trait( trait_STR_ALPHA ) );
 }
 
+
+static npc &heavily_mutated_npc( npc &dummy )
+{
+    dummy.set_body();
+    for( const mutation_category_id &cat : {
+             mutation_category_BIRD, mutation_category_FELINE, mutation_category_TROGLOBITE
+         } ) {
+        dummy.give_all_mutations( mutation_category_trait::get_all().at( cat ), true );
+    }
+    return dummy;
+}
+
+TEST_CASE( "has_trait_agrees_with_the_mutation_list", "[mutations]" )
+{
+    npc dummy;
+    heavily_mutated_npc( dummy );
+    std::vector<trait_id> muts = dummy.get_mutations();
+    REQUIRE( muts.size() > 10 );
+
+    const auto mismatches = [&dummy]( const std::vector<trait_id> &expected ) {
+        std::vector<trait_id> ret;
+        for( const mutation_branch &mut : mutation_branch::get_all() ) {
+            const bool listed = std::find( expected.begin(), expected.end(), mut.id ) != expected.end();
+            if( dummy.has_trait( mut.id ) != listed ) {
+                ret.push_back( mut.id );
+            }
+        }
+        return ret;
+    };
+    CHECK( mismatches( muts ).empty() );
+
+    const trait_id removed = muts.back();
+    dummy.unset_mutation( removed );
+    CHECK_FALSE( dummy.has_trait( removed ) );
+    CHECK( mismatches( dummy.get_mutations() ).empty() );
+
+    CHECK_FALSE( dummy.has_trait( trait_id( "not_a_loaded_trait" ) ) );
+}
+
+TEST_CASE( "has_trait_benchmark", "[.][mutations][benchmark]" )
+{
+    npc dummy;
+    heavily_mutated_npc( dummy );
+    BENCHMARK( "has_trait over all traits" ) {
+        int found = 0;
+        for( const mutation_branch &mut : mutation_branch::get_all() ) {
+            found += dummy.has_trait( mut.id );
+        }
+        return found;
+    };
+}
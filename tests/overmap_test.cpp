@@ -1,4 +1,6 @@
 #include <memory>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "all_enum_values.h"
@@ -9,14 +11,18 @@
 #include "common_types.h"
 #include "coordinates.h"
 #include "enums.h"
+#include "flexbuffer_json.h"
 #include "game.h"
 #include "game_constants.h"
 #include "global_vars.h"
 #include "item_factory.h"
+#include "json_loader.h"
 #include "itype.h"
 #include "map.h"
 #include "map_iterator.h"
 #include "mapbuffer.h"
+#include "memory_fast.h"
+#include "npc.h"
 #include "omdata.h"
 #include "output.h"
 #include "overmap.h"
@@ -27,11 +33,14 @@
 #include "vehicle.h"
 #include "vpart_position.h"
 
+static const npc_template_id npc_template_thug( "thug" );
+
 static const oter_str_id oter_cabin( "cabin" );
 static const oter_str_id oter_cabin_east( "cabin_east" );
 static const oter_str_id oter_cabin_north( "cabin_north" );
 static const oter_str_id oter_cabin_south( "cabin_south" );
 static const oter_str_id oter_cabin_west( "cabin_west" );
+static const oter_str_id oter_open_air( "open_air" );
 
 static const overmap_special_id overmap_special_Cabin( "Cabin" );
 static const overmap_special_id overmap_special_Lab( "Lab" );
@@ -57,6 +66,97 @@ TEST_CASE( "set_and_get_overmap_scents", "[overmap]" )
     REQUIRE( test_overmap->scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
 
+TEST_CASE( "overmap_terrain_survives_save_and_load", "[overmap]" )
+{
+    std::unique_ptr<overmap> saved = std::make_unique<overmap>( point_abs_om() );
+    // Wraps around the end of a row, as runs in the save file do.
+    for( int x = OMAPX - 3; x < OMAPX; ++x ) {
+        saved->ter_set( { x, 7, 0 }, oter_cabin_north.id() );
+    }
+    for( int x = 0; x < 3; ++x ) {
+        saved->ter_set( { x, 8, 0 }, oter_cabin_north.id() );
+    }
+    saved->ter_set( { 5, 5, -3 }, oter_open_air.id() );
+
+    std::ostringstream first_save;
+    saved->serialize( first_save );
+    const std::string data = first_save.str();
+    // Skip the version line.
+    JsonValue jsin = json_loader::from_string( data.substr( data.find( '\n' ) + 1 ) );
+    std::unique_ptr<overmap> loaded = std::make_unique<overmap>( point_abs_om() );
+    loaded->unserialize( jsin.get_object() );
+
+    // Layers nobody looked at are written back as they were read.
+    std::ostringstream second_save;
+    loaded->serialize( second_save );
+    CHECK( second_save.str() == data );
+
+    int mismatches = 0;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                if( loaded->ter( { x, y, z } ) != saved->ter( { x, y, z } ) ) {
+                    ++mismatches;
+                }
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+    CHECK( loaded->ter( { OMAPX - 1, 7, 0 } ) == oter_cabin_north.id() );
+    CHECK( loaded->ter( { 0, 8, 0 } ) == oter_cabin_north.id() );
+    CHECK( loaded->ter( { 5, 5, -3 } ) == oter_open_air.id() );
+}
+
+static std::unique_ptr<overmap> reload( const overmap &om )
+{
+    std::ostringstream os;
+    om.serialize( os );
+    const std::string data = os.str();
+    // Skip the version line.
+    JsonValue jsin = json_loader::from_string( data.substr( data.find( '\n' ) + 1 ) );
+    std::unique_ptr<overmap> loaded = std::make_unique<overmap>( om.pos() );
+    loaded->unserialize( jsin.get_object() );
+    return loaded;
+}
+
+TEST_CASE( "overmap_npcs_survive_save_and_load_while_dormant", "[overmap][npc]" )
+{
+    std::unique_ptr<overmap> saved = std::make_unique<overmap>( point_abs_om() );
+    std::vector<shared_ptr_fast<npc>> npcs;
+    for( int i = 0; i < 3; ++i ) {
+        shared_ptr_fast<npc> guy = make_shared_fast<npc>();
+        guy->normalize();
+        guy->load_npc_template( npc_template_thug );
+        guy->spawn_at_precise( project_to<coords::ms>( tripoint_abs_omt( 10 + i * 60, 20, 0 ) ) );
+        saved->insert_npc( guy );
+        npcs.push_back( guy );
+    }
+
+    std::unique_ptr<overmap> loaded = reload( *saved );
+    loaded->mark_saved();
+    // Nothing woke them, so there is nothing new to save.
+    CHECK_FALSE( loaded->modified_since_save() );
+    // Written back without being deserialized, and read again.
+    loaded = reload( *loaded );
+
+    shared_ptr_fast<npc> found = loaded->find_npc( npcs[1]->getID() );
+    REQUIRE( found );
+    CHECK( found->get_name() == npcs[1]->get_name() );
+    CHECK( found->get_location() == npcs[1]->get_location() );
+    CHECK( loaded->modified_since_save() );
+
+    const std::vector<shared_ptr_fast<npc>> &all = loaded->get_npcs();
+    REQUIRE( all.size() == npcs.size() );
+    for( const shared_ptr_fast<npc> &guy : npcs ) {
+        const shared_ptr_fast<npc> match = loaded->find_npc( guy->getID() );
+        REQUIRE( match );
+        CHECK( match->get_name() == guy->get_name() );
+        CHECK( match->get_location() == guy->get_location() );
+        CHECK( match->get_fac_id() == guy->get_fac_id() );
+        CHECK( match->inv_dump().size() == guy->inv_dump().size() );
+    }
+}
+
 TEST_CASE( "default_overmap_generation_always_succeeds", "[overmap][slow]" )
 {
     overmap_buffer.clear();
@@ -81,6 +181,71 @@ TEST_CASE( "default_overmap_generation_always_succeeds", "[overmap][slow]" )
     }
 }
 
+TEST_CASE( "overmap_neighbors_are_prepared_near_edges", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    const point_abs_om origin;
+    const tripoint_abs_omt center = project_combine( origin, tripoint_om_omt( OMAPX / 2, OMAPY / 2,
+                                    0 ) );
+    CHECK_FALSE( overmap_buffer.prepare_neighbors( center ) );
+
+    // Next to the north east corner, one overmap per call: north, east, then the diagonal.
+    const tripoint_abs_omt corner = project_combine( origin, tripoint_om_omt( OMAPX - 1, 0, 0 ) );
+    REQUIRE( overmap_buffer.prepare_neighbors( corner ) );
+    CHECK( overmap_buffer.get_existing( origin + point_north ) != nullptr );
+    CHECK( overmap_buffer.get_existing( origin + point_east ) == nullptr );
+    REQUIRE( overmap_buffer.prepare_neighbors( corner ) );
+    CHECK( overmap_buffer.get_existing( origin + point_east ) != nullptr );
+    CHECK( overmap_buffer.get_existing( origin + point_north_east ) == nullptr );
+    REQUIRE( overmap_buffer.prepare_neighbors( corner ) );
+    CHECK( overmap_buffer.get_existing( origin + point_north_east ) != nullptr );
+    CHECK_FALSE( overmap_buffer.prepare_neighbors( corner ) );
+}
+
+TEST_CASE( "overmap_terrain_search_matches_tile_scan", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    // Close to a corner, so the search covers several overmaps.
+    const tripoint_abs_omt origin( OMAPX - 5, 5, 0 );
+    const int radius = 30;
+    const std::pair<std::string, ot_match_type> target = GENERATE(
+                std::make_pair( std::string( "field" ), ot_match_type::type ),
+                std::make_pair( std::string( "road" ), ot_match_type::prefix ),
+                std::make_pair( std::string( "forest" ), ot_match_type::contains ) );
+    CAPTURE( target.first );
+
+    std::vector<tripoint_abs_omt> expected;
+    for( const tripoint_abs_omt &p : closest_points_first( origin, 3, radius ) ) {
+        if( overmap_buffer.check_ot( target.first, target.second, p ) ) {
+            expected.push_back( p );
+        }
+    }
+
+    omt_find_params params;
+    params.types.push_back( target );
+    params.min_distance = 3;
+    params.search_range = radius;
+    CHECK( overmap_buffer.find_all( origin, params ) == expected );
+
+    params.min_z = 0;
+    params.max_z = 0;
+    const tripoint_abs_omt closest = overmap_buffer.find_closest( origin, params );
+    if( expected.empty() ) {
+        CHECK( closest == overmap::invalid_tripoint );
+    } else {
+        CHECK( square_dist( origin, closest ) == square_dist( origin, expected.front() ) );
+        CHECK( overmap_buffer.check_ot( target.first, target.second, closest ) );
+    }
+
+    // Changing the terrain is picked up by the next search.
+    if( !expected.empty() ) {
+        overmap_buffer.ter_set( expected.front(), oter_open_air.id() );
+        const std::vector<tripoint_abs_omt> found = overmap_buffer.find_all( origin, params );
+        CHECK( std::find( found.begin(), found.end(), expected.front() ) == found.end() );
+        CHECK( found.size() + 1 == expected.size() );
+    }
+}
+
 TEST_CASE( "default_overmap_generation_has_non_mandatory_specials_at_origin", "[overmap][slow]" )
 {
     const point_abs_om origin{};
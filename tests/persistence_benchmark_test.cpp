@@ -0,0 +1,299 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "avatar.h"
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "filesystem.h"
+#include "flexbuffer_json.h"
+#include "game.h"
+#include "game_constants.h"
+#include "item.h"
+#include "json.h"
+#include "json_loader.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_memory.h"
+#include "mapbuffer.h"
+#include "memory_fast.h"
+#include "npc.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "type_id.h"
+#include "units.h"
+
+static const field_type_str_id field_fd_blood( "fd_blood" );
+
+static const itype_id itype_backpack_hiking( "backpack_hiking" );
+static const itype_id itype_test_rag( "test_rag" );
+
+static const npc_template_id npc_template_thug( "thug" );
+
+static const oter_str_id oter_field( "field" );
+static const oter_str_id oter_forest( "forest" );
+
+static const ter_str_id ter_t_wall( "t_wall" );
+
+static const vproto_id vehicle_prototype_bicycle( "bicycle" );
+
+// Save / load throughput of the persistence code on a synthetic world that is the same on
+// every run. Run with
+//     cata_test "[persistence][benchmark]"
+// and pick the "persistence_benchmark" lines out of the output: each one is a JSON object
+// with the stage, its wall time in milliseconds, the bytes it wrote or read and how many
+// things (submaps, overmaps, ...) that was.
+
+// Size of the synthetic world, besides the reality bubble.
+static constexpr int num_overmaps = 4;
+static constexpr int npcs_per_overmap = 25;
+static constexpr int num_memory_regions = 16;
+
+template<typename F>
+static double wall_time_ms( F &&f )
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>( elapsed ).count();
+}
+
+static void report( const char *stage, double ms, size_t bytes, int count )
+{
+    printf( "persistence_benchmark {\"stage\":\"%s\",\"ms\":%.3f,\"bytes\":%zu,\"count\":%d}\n",
+            stage, ms, bytes, count );
+}
+
+static size_t directory_size( const fs::path &dir )
+{
+    size_t total = 0;
+    std::error_code ec;
+    for( const fs::directory_entry &entry : fs::recursive_directory_iterator( dir, ec ) ) {
+        if( entry.is_regular_file( ec ) ) {
+            total += entry.file_size( ec );
+        }
+    }
+    return total;
+}
+
+static void populate_reality_bubble()
+{
+    clear_map();
+    map &here = get_map();
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const tripoint_bub_ms p( x, y, 0 );
+            if( x % 12 == 0 && y % 12 < 8 ) {
+                here.ter_set( p, ter_t_wall );
+            } else if( ( x + y ) % 5 == 0 ) {
+                item rag( itype_test_rag );
+                rag.set_var( "counter", x * MAPSIZE_Y + y );
+                here.add_item( p, rag );
+            } else if( ( x * y ) % 17 == 3 ) {
+                here.add_field( p, field_fd_blood, 1 + x % 3, 0_turns, false );
+            }
+        }
+    }
+    for( int i = 0; i < 12; ++i ) {
+        const tripoint_bub_ms p( 6 + i * 10, MAPSIZE_Y / 2 + ( i % 3 ) * 6, 0 );
+        here.add_vehicle( vehicle_prototype_bicycle, p, 0_degrees, 0, 0 );
+    }
+    for( int i = 0; i < 10; ++i ) {
+        npc &guy = spawn_npc( point( 8 + i * 12, 20 ), "thug" );
+        guy.i_add( item( itype_backpack_hiking ) );
+    }
+}
+
+static std::unique_ptr<overmap> make_overmap( const point_abs_om &pos )
+{
+    std::unique_ptr<overmap> om = std::make_unique<overmap>( pos );
+    for( int z = -2; z <= 0; ++z ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                // Irregular enough that the runs stay short.
+                if( rng( 0, 3 ) == 0 ) {
+                    const oter_id ter = rng( 0, 1 ) ? oter_forest.id() : oter_field.id();
+                    om->ter_set( tripoint_om_omt( x, y, z ), ter );
+                }
+            }
+        }
+    }
+    for( int i = 0; i < npcs_per_overmap; ++i ) {
+        shared_ptr_fast<npc> guy = make_shared_fast<npc>();
+        guy->normalize();
+        guy->load_npc_template( npc_template_thug );
+        guy->spawn_at_precise( project_to<coords::ms>(
+                                   project_combine( pos, tripoint_om_omt( 10 + i, 20 + i, 0 ) ) ) );
+        om->insert_npc( guy );
+    }
+    return om;
+}
+
+static std::string to_json( const std::function<void( JsonOut & )> &f )
+{
+    std::ostringstream os;
+    {
+        JsonOut jsout( os );
+        f( jsout );
+    }
+    return os.str();
+}
+
+TEST_CASE( "save_load_throughput", "[.][persistence][benchmark]" )
+{
+    rng_set_engine_seed( 4242 );
+
+    // --- map quads ---
+    populate_reality_bubble();
+    map &here = get_map();
+    const fs::path maps_dir = fs::u8path( PATH_INFO::world_base_save_path() + "/maps" );
+    std::vector<tripoint_abs_sm> bubble;
+    for( int x = 0; x < MAPSIZE; ++x ) {
+        for( int y = 0; y < MAPSIZE; ++y ) {
+            bubble.push_back( here.get_abs_sub() + tripoint_rel_sm( x, y, 0 ) );
+        }
+    }
+    const double save_ms = wall_time_ms( []() {
+        MAPBUFFER.save();
+    } );
+    report( "mapbuffer_save", save_ms, directory_size( maps_dir ),
+            static_cast<int>( bubble.size() ) );
+
+    {
+        // A second buffer, so the submaps of the reality bubble stay where they are.
+        mapbuffer loaded;
+        int found = 0;
+        const double load_ms = wall_time_ms( [&]() {
+            for( const tripoint_abs_sm &p : bubble ) {
+                found += loaded.lookup_submap( p ) != nullptr;
+            }
+        } );
+        report( "mapbuffer_lookup_submap", load_ms, directory_size( maps_dir ), found );
+        CHECK( found == static_cast<int>( bubble.size() ) );
+    }
+
+    // --- overmaps ---
+    std::vector<std::unique_ptr<overmap>> overmaps;
+    for( int i = 0; i < num_overmaps; ++i ) {
+        // Far away from anything the other tests generate.
+        overmaps.push_back( make_overmap( point_abs_om( 100 + i, 100 ) ) );
+    }
+    std::vector<std::string> overmap_saves;
+    size_t overmap_bytes = 0;
+    const double om_save_ms = wall_time_ms( [&]() {
+        for( const std::unique_ptr<overmap> &om : overmaps ) {
+            std::ostringstream os;
+            om->serialize( os );
+            overmap_saves.push_back( os.str() );
+            overmap_bytes += overmap_saves.back().size();
+        }
+    } );
+    report( "overmap_serialize", om_save_ms, overmap_bytes, num_overmaps );
+
+    std::vector<std::unique_ptr<overmap>> loaded_overmaps;
+    const double om_load_ms = wall_time_ms( [&]() {
+        for( int i = 0; i < num_overmaps; ++i ) {
+            const std::string &data = overmap_saves[i];
+            // Skip the version line, like the game does.
+            JsonValue jsin = json_loader::from_string( data.substr( data.find( '\n' ) + 1 ) );
+            std::unique_ptr<overmap> om = std::make_unique<overmap>( point_abs_om( 100 + i, 100 ) );
+            om->unserialize( jsin.get_object() );
+            loaded_overmaps.push_back( std::move( om ) );
+        }
+    } );
+    report( "overmap_unserialize", om_load_ms, overmap_bytes, num_overmaps );
+
+    // The npcs are only deserialized once something needs them.
+    int npcs_loaded = 0;
+    const double npc_wake_ms = wall_time_ms( [&]() {
+        for( const std::unique_ptr<overmap> &om : loaded_overmaps ) {
+            npcs_loaded += static_cast<int>( om->get_npcs().size() );
+        }
+    } );
+    report( "overmap_npc_wake", npc_wake_ms, 0, npcs_loaded );
+    CHECK( npcs_loaded == num_overmaps * npcs_per_overmap );
+
+    // --- map memory ---
+    std::vector<mm_region> regions( num_memory_regions );
+    for( mm_region &reg : regions ) {
+        for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+            for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+                reg.submaps[x][y] = make_shared_fast<mm_submap>();
+                for( int tx = 0; tx < SEEX; tx++ ) {
+                    for( int ty = 0; ty < SEEY; ty++ ) {
+                        memorized_tile tile;
+                        tile.set_ter_id( rng( 0, 4 ) ? "t_grass" : "t_wall" );
+                        tile.set_ter_rotation( rng( 0, 3 ) );
+                        if( rng( 0, 6 ) == 0 ) {
+                            tile.set_dec_id( "f_chair" );
+                        }
+                        reg.submaps[x][y]->set_tile( point_sm_ms( tx, ty ), tile );
+                    }
+                }
+            }
+        }
+    }
+    std::vector<std::string> region_saves;
+    size_t region_bytes = 0;
+    const double mm_save_ms = wall_time_ms( [&]() {
+        for( const mm_region &reg : regions ) {
+            region_saves.push_back( to_json( [&reg]( JsonOut & jsout ) {
+                reg.serialize( jsout );
+            } ) );
+            region_bytes += region_saves.back().size();
+        }
+    } );
+    report( "map_memory_save", mm_save_ms, region_bytes, num_memory_regions );
+
+    const double mm_load_ms = wall_time_ms( [&]() {
+        for( const std::string &data : region_saves ) {
+            mm_region reg;
+            reg.deserialize( json_loader::from_string( data ) );
+        }
+    } );
+    report( "map_memory_load", mm_load_ms, region_bytes, num_memory_regions );
+
+    // --- characters ---
+    avatar &u = get_avatar();
+    for( int i = 0; i < 20; ++i ) {
+        u.i_add( item( itype_test_rag ) );
+    }
+    std::vector<std::string> npc_saves;
+    size_t character_bytes = 0;
+    const double char_save_ms = wall_time_ms( [&]() {
+        character_bytes += to_json( [&u]( JsonOut & jsout ) {
+            u.serialize( jsout );
+        } ).size();
+        for( const std::unique_ptr<overmap> &om : overmaps ) {
+            for( const shared_ptr_fast<npc> &guy : om->get_npcs() ) {
+                npc_saves.push_back( to_json( [&guy]( JsonOut & jsout ) {
+                    guy->serialize( jsout );
+                } ) );
+                character_bytes += npc_saves.back().size();
+            }
+        }
+    } );
+    report( "character_serialize", char_save_ms, character_bytes,
+            static_cast<int>( npc_saves.size() ) + 1 );
+
+    size_t npc_bytes = 0;
+    const double char_load_ms = wall_time_ms( [&]() {
+        for( const std::string &data : npc_saves ) {
+            npc guy;
+            guy.deserialize( json_loader::from_string( data ).get_object() );
+            npc_bytes += data.size();
+        }
+    } );
+    report( "character_deserialize", char_load_ms, npc_bytes,
+            static_cast<int>( npc_saves.size() ) );
+}
@@ -115,3 +115,30 @@ TEST_CASE( "submap_rotation2", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap_tracks_modifications_since_save", "[submap]" )
+{
+    submap sm;
+    // Never saved yet
+    CHECK( sm.modified_since_save() );
+
+    sm.mark_saved();
+    CHECK_FALSE( sm.modified_since_save() );
+    // Reading doesn't count as a change
+    CHECK( sm.get_ter( point_zero ) == sm.get_ter( point_east ) );
+    CHECK_FALSE( sm.modified_since_save() );
+
+    sm.set_ter( point_zero, ter_id( 1 ) );
+    CHECK( sm.modified_since_save() );
+    sm.mark_saved();
+
+    // The item stack may be changed through the returned reference
+    sm.get_items( point_zero );
+    CHECK( sm.modified_since_save() );
+    sm.mark_saved();
+
+    sm.set_signage( point_south, "sign" );
+    CHECK( sm.modified_since_save() );
+    sm.mark_saved();
+    CHECK_FALSE( sm.modified_since_save() );
+}
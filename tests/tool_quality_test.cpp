@@ -1,9 +1,14 @@
+#include <climits>
+
 #include "avatar.h"
 #include "cata_catch.h"
+#include "inventory.h"
 #include "itype.h"
 #include "player_helpers.h"
 #include "type_id.h"
 
+static const itype_id itype_test_sonic_screwdriver( "test_sonic_screwdriver" );
+
 static const quality_id qual_BOIL( "BOIL" );
 static const quality_id qual_DRILL( "DRILL" );
 static const quality_id qual_LOCKPICK( "LOCKPICK" );
@@ -206,3 +211,31 @@ TEST_CASE( "battery-powered_tool_qualities", "[tool][battery][quality]" )
     }
 }
 
+
+// inventory::has_quality and inventory::max_quality
+//
+// Answered from per-quality level counts, which must follow items added to and removed
+// from the inventory.
+//
+TEST_CASE( "inventory_quality_levels", "[tool][quality][inventory]" )
+{
+    inventory inv;
+    CHECK_FALSE( inv.has_quality( qual_SCREW ) );
+    CHECK( inv.max_quality( qual_SCREW ) == INT_MIN );
+
+    inv.add_item( item( itype_test_sonic_screwdriver ) );
+    CHECK( inv.has_quality( qual_SCREW, 2 ) );
+    CHECK_FALSE( inv.has_quality( qual_SCREW, 3 ) );
+    CHECK_FALSE( inv.has_quality( qual_SCREW, 2, 2 ) );
+    CHECK( inv.max_quality( qual_LOCKPICK ) == 30 );
+
+    inv.add_item( item( itype_test_sonic_screwdriver ) );
+    CHECK( inv.has_quality( qual_SCREW, 1, 2 ) );
+    CHECK_FALSE( inv.has_quality( qual_SCREW, 1, 3 ) );
+
+    inv.remove_items_with( []( const item & it ) {
+        return it.typeId() == itype_test_sonic_screwdriver;
+    } );
+    CHECK_FALSE( inv.has_quality( qual_SCREW ) );
+    CHECK( inv.max_quality( qual_LOCKPICK ) == INT_MIN );
+}
@@ -0,0 +1,90 @@
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "cata_catch.h"
+#include "filesystem.h"
+#include "path_info.h"
+#include "world_backup.h"
+
+static void write_file( const fs::path &path, const std::string &contents )
+{
+    fs::create_directories( path.parent_path() );
+    std::ofstream fout( path, std::ios::binary );
+    fout << contents;
+}
+
+static std::string read_file( const fs::path &path )
+{
+    std::ifstream fin( path, std::ios::binary );
+    return std::string( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+}
+
+static size_t count_files( const fs::path &dir )
+{
+    size_t count = 0;
+    std::error_code ec;
+    for( const fs::directory_entry &entry : fs::recursive_directory_iterator( dir, ec ) ) {
+        count += entry.is_regular_file();
+    }
+    return count;
+}
+
+TEST_CASE( "world_backups_restore_every_snapshot", "[world_backup][nogame]" )
+{
+    const fs::path root = fs::u8path( PATH_INFO::savedir() ) / "world_backup_test";
+    fs::remove_all( root );
+    const fs::path world = root / "world";
+    const fs::path store = world_backup::store_for( world );
+    CHECK( store == root / "world.backup" );
+
+    std::string big;
+    for( int i = 0; big.size() < 200 * 1024; ++i ) {
+        big += "{ \"id\": " + std::to_string( i ) + " },\n";
+    }
+    write_file( world / "master.gsav", "{}" );
+    write_file( world / "maps" / "0.0.0" / "1.1.0.map", big );
+    // Same contents as the one above, stored once.
+    write_file( world / "maps" / "0.0.0" / "2.1.0.map", big );
+    write_file( world / "o.0.0", "overmap" );
+    write_file( world / "o.1.0.temp", "half written" );
+    write_file( world / "cache" / "o.0.0.1234.fb", "flexbuffer" );
+
+    std::string error;
+    const std::optional<std::string> first = world_backup::create( world, store, error );
+    REQUIRE( first );
+    CHECK( error.empty() );
+    CHECK( count_files( store / "blobs" ) == 3 );
+
+    write_file( world / "o.0.0", "overmap, changed" );
+    write_file( world / "o.1.0", "new overmap" );
+    const std::optional<std::string> second = world_backup::create( world, store, error );
+    REQUIRE( second );
+    // Only the new contents were added.
+    CHECK( count_files( store / "blobs" ) == 5 );
+    CHECK( world_backup::snapshots( store ) == std::vector<std::string> { *first, *second } );
+
+    const fs::path old_world = root / "restored_first";
+    REQUIRE( world_backup::restore( store, *first, old_world, error ) );
+    CHECK( count_files( old_world ) == 4 );
+    CHECK( read_file( old_world / "maps" / "0.0.0" / "2.1.0.map" ) == big );
+    CHECK( read_file( old_world / "o.0.0" ) == "overmap" );
+    CHECK_FALSE( fs::exists( old_world / "o.1.0.temp" ) );
+    CHECK_FALSE( fs::exists( old_world / "cache" ) );
+
+    const fs::path new_world = root / "restored_second";
+    REQUIRE( world_backup::restore( store, *second, new_world, error ) );
+    CHECK( count_files( new_world ) == 5 );
+    CHECK( read_file( new_world / "o.0.0" ) == "overmap, changed" );
+    CHECK( read_file( new_world / "o.1.0" ) == "new overmap" );
+
+    // Never over an existing directory.
+    CHECK_FALSE( world_backup::restore( store, *first, new_world, error ) );
+    CHECK_FALSE( error.empty() );
+
+    fs::remove_all( root );
+}